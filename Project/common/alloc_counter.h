@@ -0,0 +1,26 @@
+/**
+ * @file alloc_counter.h
+ * @brief Counts heap allocations to catch allocations in the time loop.
+ *
+ * When WAVE_COUNT_ALLOCATIONS is defined (test builds and make ALLOC_CHECK=1),
+ * alloc_counter.cpp replaces the global operator new and counts every call
+ * from every thread. All standard containers allocate through it, so a time
+ * step that leaves the count unchanged performs no heap allocations. Without
+ * the macro the count is always zero and nothing is replaced.
+ */
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#ifdef WAVE_COUNT_ALLOCATIONS
+/** @brief Whether allocations are counted. */
+const bool allocationCountingEnabled = true;
+#else
+const bool allocationCountingEnabled = false;
+#endif
+
+/**
+ * @brief Returns the number of calls to operator new since the program started.
+ */
+long long allocationCount();
+
+#endif // ALLOC_COUNTER_H
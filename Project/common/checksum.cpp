@@ -0,0 +1,118 @@
+/**
+ * @file checksum.cpp
+ * @brief Implementation of the field checksums declared in checksum.h.
+ */
+
+#include "checksum.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @brief Mixes the bits of a 64-bit value (finalizer of splitmix64).
+ */
+static uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * @brief Returns the hash of one cell.
+ */
+static uint64_t cellHash(uint64_t index, double value) {
+    // -0.0 and 0.0 compare equal, and backends differ in which one a wall holds
+    uint64_t bits = 0;
+    if (value != 0.0) {
+        std::memcpy(&bits, &value, sizeof(bits));
+    }
+    return mix(bits ^ mix(index + 0x9e3779b97f4a7c15ULL));
+}
+
+FieldChecksum emptyChecksum(long long step) {
+    FieldChecksum checksum;
+    checksum.step = step;
+    checksum.hash = 0;
+    checksum.sum = 0.0;
+    checksum.energy = 0.0;
+    return checksum;
+}
+
+void addRow(FieldChecksum& checksum, int row, const double* values, int n) {
+    uint64_t first = static_cast<uint64_t>(row) * n;
+    for (int j = 0; j < n; ++j) {
+        checksum.hash += cellHash(first + j, values[j]);
+        checksum.sum += values[j];
+        checksum.energy += values[j] * values[j];
+    }
+}
+
+void addChecksum(FieldChecksum& checksum, const FieldChecksum& part) {
+    checksum.hash += part.hash;
+    checksum.sum += part.sum;
+    checksum.energy += part.energy;
+}
+
+FieldChecksum fieldChecksum(const std::vector<std::vector<double>>& U, long long step) {
+    FieldChecksum checksum = emptyChecksum(step);
+    const int n = static_cast<int>(U.size());
+    for (int i = 0; i < n; ++i) {
+        addRow(checksum, i, U[i].data(), n);
+    }
+    return checksum;
+}
+
+bool checksumsMatch(const FieldChecksum& a, const FieldChecksum& b, int n, double tolerance) {
+    if (a.step != b.step) {
+        return false;
+    }
+    if (tolerance == 0.0) {
+        return a.hash == b.hash;
+    }
+    double energy = std::max(a.energy, b.energy);
+    return std::fabs(a.energy - b.energy) <= tolerance * energy
+        && std::fabs(a.sum - b.sum) <= tolerance * std::sqrt(static_cast<double>(n) * n * energy);
+}
+
+long firstDivergence(const std::vector<FieldChecksum>& a, const std::vector<FieldChecksum>& b, int n,
+                     double tolerance) {
+    size_t common = std::min(a.size(), b.size());
+    for (size_t k = 0; k < common; ++k) {
+        if (!checksumsMatch(a[k], b[k], n, tolerance)) {
+            return static_cast<long>(k);
+        }
+    }
+    return a.size() == b.size() ? -1 : static_cast<long>(common);
+}
+
+bool writeChecksums(const std::string& path, const std::vector<FieldChecksum>& checksums) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    for (size_t k = 0; k < checksums.size(); ++k) {
+        const FieldChecksum& c = checksums[k];
+        std::fprintf(file, "%lld %016" PRIx64 " %.17g %.17g\n", c.step, c.hash, c.sum, c.energy);
+    }
+    return std::fclose(file) == 0;
+}
+
+bool readChecksums(const std::string& path, std::vector<FieldChecksum>& checksums) {
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (file == nullptr) {
+        return false;
+    }
+    checksums.clear();
+    FieldChecksum c;
+    int fields;
+    while ((fields = std::fscanf(file, "%lld %" SCNx64 " %lf %lf", &c.step, &c.hash, &c.sum, &c.energy)) == 4) {
+        checksums.push_back(c);
+    }
+    std::fclose(file);
+    return fields == EOF;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file checksum.h
+ * @brief Cheap order-independent checksums of the field for comparing backends.
+ *
+ * Every cell contributes a 64-bit hash of its global index and the bit pattern
+ * of its value, and the checksum of a field is the sum of these hashes modulo
+ * 2^64. Addition commutes, so rows, bands, threads and ranks can compute
+ * their parts in any order and add them up: two fields with the same hash are
+ * equal bit for bit with overwhelming probability, however they were
+ * partitioned. The sum of U and of U^2 are carried along for comparisons
+ * that tolerate rounding, e.g. of a mirrored simulation.
+ *
+ * Checksum files are text, one checksum per line:
+ * step, hash in hexadecimal, sum and energy.
+ */
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Checksum of the field after a number of steps.
+ */
+struct FieldChecksum {
+    long long step;  /**< Steps taken */
+    uint64_t hash;   /**< Sum of the cell hashes modulo 2^64 */
+    double sum;      /**< Sum of U */
+    double energy;   /**< Sum of U^2 */
+};
+
+/**
+ * @brief Returns the checksum of an empty set of cells at a step.
+ */
+FieldChecksum emptyChecksum(long long step);
+
+/**
+ * @brief Adds the cells of one row of an n x n grid to a checksum.
+ *
+ * @param checksum Checksum to add to.
+ * @param row Global row index.
+ * @param values The n values of the row.
+ * @param n Grid size.
+ */
+void addRow(FieldChecksum& checksum, int row, const double* values, int n);
+
+/**
+ * @brief Adds a partial checksum of the same step, e.g. of another rank.
+ */
+void addChecksum(FieldChecksum& checksum, const FieldChecksum& part);
+
+/**
+ * @brief Returns the checksum of a full n x n field.
+ *
+ * @param U Grid values.
+ * @param step Steps taken.
+ */
+FieldChecksum fieldChecksum(const std::vector<std::vector<double>>& U, long long step);
+
+/**
+ * @brief Returns whether two checksums agree.
+ *
+ * @param a First checksum.
+ * @param b Second checksum.
+ * @param n Grid size.
+ * @param tolerance 0 compares the hashes, i.e. bit for bit. Otherwise the sum
+ *                  and energy must agree to this relative tolerance; the sum
+ *                  is measured against its bound sqrt(n^2 energy).
+ */
+bool checksumsMatch(const FieldChecksum& a, const FieldChecksum& b, int n, double tolerance);
+
+/**
+ * @brief Returns the position of the first checksum at which two runs differ.
+ *
+ * @param a Checksums of the first run.
+ * @param b Checksums of the second run.
+ * @param n Grid size.
+ * @param tolerance See checksumsMatch().
+ * @return Index of the first differing pair, the length of the shorter run if
+ *         one is a prefix of the other, or -1 if both agree.
+ */
+long firstDivergence(const std::vector<FieldChecksum>& a, const std::vector<FieldChecksum>& b, int n,
+                     double tolerance);
+
+/**
+ * @brief Writes checksums to a text file.
+ *
+ * @return false if the file cannot be written.
+ */
+bool writeChecksums(const std::string& path, const std::vector<FieldChecksum>& checksums);
+
+/**
+ * @brief Reads checksums written by writeChecksums().
+ *
+ * @return false if the file cannot be read or is malformed.
+ */
+bool readChecksums(const std::string& path, std::vector<FieldChecksum>& checksums);
+
+#endif // CHECKSUM_H
@@ -0,0 +1,262 @@
+/**
+ * @file geometry.cpp
+ * @brief Implementation of the geometry files declared in geometry.h.
+ */
+
+#include "geometry.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+int gridIndex(double fraction, int n) {
+    return static_cast<int>(std::floor(fraction * n + 1e-9));
+}
+
+/**
+ * @brief Returns a rectangle shape.
+ */
+static Shape rectangle(bool wall, double x0, double y0, double x1, double y1) {
+    Shape shape;
+    shape.kind = Shape::RECTANGLE;
+    shape.wall = wall;
+    shape.points = { x0, y0, x1, y1 };
+    shape.width = shape.height = 0;
+    shape.offset = 0;
+    shape.threshold = 0;
+    return shape;
+}
+
+Geometry slitGeometry(double slitWidth, double slitSpacing) {
+    // The barrier spans the whole width; the openings are cut into it
+    double left = 0.5 - 0.5 * slitSpacing;
+    double right = 0.5 + 0.5 * slitSpacing;
+    double half = 0.5 * slitWidth;
+    Geometry geometry;
+    geometry.shapes.push_back(rectangle(true, 0.0, 1.0 / 4, 1.0, 9.0 / 32));
+    geometry.shapes.push_back(rectangle(false, left - half, 0.0, left + half, 1.0));
+    geometry.shapes.push_back(rectangle(false, right - half, 0.0, right + half, 1.0));
+    return geometry;
+}
+
+/**
+ * @brief Reads the header of a binary PGM file into a bitmap shape.
+ */
+static bool readBitmapHeader(Shape& shape, std::string& error) {
+    std::ifstream in(shape.path.c_str(), std::ios::binary);
+    std::string magic;
+    if (!(in >> magic) || magic != "P5") {
+        error = shape.path + " is not a binary PGM (P5) file";
+        return false;
+    }
+
+    // Width, height and maximum value, with optional comments in between
+    int values[3];
+    for (int v = 0; v < 3; ++v) {
+        in >> std::ws;
+        while (in.peek() == '#') {
+            std::string comment;
+            std::getline(in, comment);
+            in >> std::ws;
+        }
+        if (!(in >> values[v]) || values[v] <= 0) {
+            error = shape.path + " has an invalid PGM header";
+            return false;
+        }
+    }
+    if (values[2] > 255) {
+        error = shape.path + " must have 8-bit pixels";
+        return false;
+    }
+
+    // A single whitespace character separates the header from the pixels
+    in.get();
+    shape.width = values[0];
+    shape.height = values[1];
+    shape.threshold = (values[2] + 1) / 2;
+    shape.offset = static_cast<long>(in.tellg());
+
+    in.seekg(0, std::ios::end);
+    if (static_cast<long>(in.tellg()) < shape.offset + static_cast<long>(shape.width) * shape.height) {
+        error = shape.path + " is shorter than its header says";
+        return false;
+    }
+    return true;
+}
+
+bool parseGeometry(const std::string& text, const std::string& directory, Geometry& geometry, std::string& error) {
+    std::istringstream lines(text);
+    std::string line;
+    geometry.shapes.clear();
+    for (int number = 1; std::getline(lines, line); ++number) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream words(line);
+        std::string first;
+        if (!(words >> first)) {
+            continue;
+        }
+        const std::string where = "line " + std::to_string(number) + ": ";
+
+        Shape shape = rectangle(first == "wall", 0.0, 0.0, 0.0, 0.0);
+        shape.points.clear();
+        if (first == "bitmap") {
+            std::string file;
+            if (!(words >> file)) {
+                error = where + "bitmap needs a file";
+                return false;
+            }
+            shape.kind = Shape::BITMAP;
+            shape.path = file[0] == '/' ? file : directory + "/" + file;
+            if (!readBitmapHeader(shape, error)) {
+                error = where + error;
+                return false;
+            }
+            geometry.shapes.push_back(shape);
+            continue;
+        }
+        if (first != "wall" && first != "open") {
+            error = where + "expected wall, open or bitmap instead of " + first;
+            return false;
+        }
+
+        std::string kind;
+        words >> kind;
+        double value;
+        while (words >> value) {
+            shape.points.push_back(value);
+        }
+        if (!words.eof()) {
+            error = where + "coordinates must be numbers";
+            return false;
+        }
+        const size_t count = shape.points.size();
+        if (kind == "rectangle" && count == 4) {
+            shape.kind = Shape::RECTANGLE;
+        } else if (kind == "circle" && count == 3) {
+            shape.kind = Shape::CIRCLE;
+        } else if (kind == "polygon" && count >= 6 && count % 2 == 0) {
+            shape.kind = Shape::POLYGON;
+        } else {
+            error = where + "expected rectangle x0 y0 x1 y1, circle cx cy r or polygon x1 y1 x2 y2 x3 y3 ...";
+            return false;
+        }
+        geometry.shapes.push_back(shape);
+    }
+    if (geometry.shapes.empty()) {
+        error = "no shapes";
+        return false;
+    }
+    return true;
+}
+
+std::string directoryOf(const std::string& path) {
+    size_t slash = path.rfind('/');
+    if (slash == std::string::npos) {
+        return ".";
+    }
+    return slash == 0 ? "/" : path.substr(0, slash);
+}
+
+bool readGeometry(const std::string& path, Geometry& geometry, std::string& error) {
+    std::ifstream in(path.c_str());
+    if (!in) {
+        error = "could not read " + path;
+        return false;
+    }
+    std::stringstream text;
+    text << in.rdbuf();
+    return parseGeometry(text.str(), directoryOf(path), geometry, error);
+}
+
+/**
+ * @brief Sets the cells whose centres lie in [x0, x1) of one row.
+ */
+static void fillSpan(std::vector<bool>& mask, size_t row, int n, double x0, double x1, bool wall) {
+    int first = std::max(0, static_cast<int>(std::ceil(x0 * n - 0.5)));
+    int last = std::min(n, static_cast<int>(std::ceil(x1 * n - 0.5)));
+    for (int j = first; j < last; ++j) {
+        mask[row + j] = wall;
+    }
+}
+
+void rasterizeRows(const Geometry& geometry, int n, int firstRow, int rows, std::vector<bool>& mask, size_t offset) {
+    for (int i = 0; i < rows; ++i) {
+        std::fill(mask.begin() + offset + static_cast<size_t>(i) * n, mask.begin() + offset + static_cast<size_t>(i + 1) * n, false);
+    }
+
+    std::vector<double> crossings;
+    std::vector<unsigned char> pixels;
+    for (const Shape& shape : geometry.shapes) {
+        const std::vector<double>& p = shape.points;
+        FILE* bitmap = nullptr;
+        long loaded = -1;
+        if (shape.kind == Shape::BITMAP) {
+            bitmap = std::fopen(shape.path.c_str(), "rb");
+            pixels.assign(shape.width, 0);
+        }
+
+        for (int i = 0; i < rows; ++i) {
+            const int global = firstRow + i;
+            const size_t row = offset + static_cast<size_t>(i) * n;
+            const double y = (global + 0.5) / n;
+            if (shape.kind == Shape::RECTANGLE) {
+                if (global >= gridIndex(p[1], n) && global < gridIndex(p[3], n)) {
+                    int last = std::min(n, gridIndex(p[2], n));
+                    for (int j = std::max(0, gridIndex(p[0], n)); j < last; ++j) {
+                        mask[row + j] = shape.wall;
+                    }
+                }
+            } else if (shape.kind == Shape::CIRCLE) {
+                double dy = y - p[1];
+                if (dy * dy <= p[2] * p[2]) {
+                    // Centres on the circle are inside, so the span is closed on the right
+                    double half = std::sqrt(p[2] * p[2] - dy * dy);
+                    fillSpan(mask, row, n, p[0] - half, std::nextafter(p[0] + half, 2.0), shape.wall);
+                }
+            } else if (shape.kind == Shape::POLYGON) {
+                // Even-odd rule along the line through the cell centres
+                crossings.clear();
+                const size_t corners = p.size() / 2;
+                for (size_t k = 0; k < corners; ++k) {
+                    double x1 = p[2 * k], y1 = p[2 * k + 1];
+                    double x2 = p[(2 * k + 2) % p.size()], y2 = p[(2 * k + 3) % p.size()];
+                    if ((y1 <= y) != (y2 <= y)) {
+                        crossings.push_back(x1 + (y - y1) * (x2 - x1) / (y2 - y1));
+                    }
+                }
+                std::sort(crossings.begin(), crossings.end());
+                for (size_t k = 0; k + 1 < crossings.size(); k += 2) {
+                    fillSpan(mask, row, n, crossings[k], crossings[k + 1], shape.wall);
+                }
+            } else if (bitmap != nullptr) {
+                // Only the pixel rows under the requested grid rows are read
+                long pixelRow = (2L * global + 1) * shape.height / (2L * n);
+                if (pixelRow != loaded) {
+                    std::fseek(bitmap, shape.offset + pixelRow * shape.width, SEEK_SET);
+                    if (std::fread(pixels.data(), 1, pixels.size(), bitmap) != pixels.size()) {
+                        std::fill(pixels.begin(), pixels.end(), 0);
+                    }
+                    loaded = pixelRow;
+                }
+                for (int j = 0; j < n; ++j) {
+                    long column = (2L * j + 1) * shape.width / (2L * n);
+                    mask[row + j] = pixels[column] < shape.threshold;
+                }
+            }
+        }
+        if (bitmap != nullptr) {
+            std::fclose(bitmap);
+        }
+    }
+
+    // The border is a wall whatever the shapes say; row 0 holds the inflow
+    for (int i = 0; i < rows; ++i) {
+        const int global = firstRow + i;
+        const size_t row = offset + static_cast<size_t>(i) * n;
+        if (global == 0 || global == n - 1) {
+            std::fill(mask.begin() + row, mask.begin() + row + n, true);
+        }
+        mask[row] = mask[row + n - 1] = true;
+    }
+}
@@ -0,0 +1,105 @@
+/**
+ * @file geometry.h
+ * @brief Obstacle geometry described by shapes and rasterized one range of rows at a time.
+ *
+ * A geometry file lists shapes that are applied in order, later ones over
+ * earlier ones, to a domain that starts open. Coordinates are fractions of the
+ * box: x runs along the columns and y along the rows, with the inflow at y = 0.
+ * Everything after a '#' is a comment.
+ *
+ *     wall rectangle <x0> <y0> <x1> <y1>
+ *     open rectangle <x0> <y0> <x1> <y1>
+ *     wall circle <cx> <cy> <r>
+ *     wall polygon <x1> <y1> <x2> <y2> <x3> <y3> ...
+ *     bitmap <file.pgm>
+ *
+ * Rectangles cover the cells from gridIndex(x0) up to but excluding
+ * gridIndex(x1), like the slits of the built-in geometry; circles and
+ * polygons (even-odd rule) cover the cells whose centres lie inside. A bitmap
+ * is a binary 8-bit PGM (P5) stretched over the whole domain, its path
+ * relative to the geometry file; dark pixels are walls and light ones open.
+ * The border of the domain is always a wall.
+ *
+ * Rows are rasterized independently, so a process only needs the rows it
+ * stores, and only reads those rows of a bitmap.
+ */
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief One shape of a geometry.
+ */
+struct Shape {
+    enum Kind { RECTANGLE, CIRCLE, POLYGON, BITMAP };
+
+    Kind kind;
+    bool wall;                  /**< Walls or openings; bitmaps set both */
+    std::vector<double> points; /**< x0 y0 x1 y1, cx cy r, or the polygon corners as x y pairs */
+    std::string path;           /**< Bitmap file */
+    int width;                  /**< Bitmap pixels per row */
+    int height;                 /**< Bitmap rows */
+    long offset;                /**< Bytes before the first bitmap pixel */
+    int threshold;              /**< Bitmap pixels below this value are walls */
+};
+
+/**
+ * @brief Shapes applied in order to an open domain.
+ */
+struct Geometry {
+    std::vector<Shape> shapes;
+};
+
+/**
+ * @brief Converts a fraction of the box into a grid index, rounding down.
+ */
+int gridIndex(double fraction, int n);
+
+/**
+ * @brief Returns the built-in geometry: a barrier across rows n/4 to 9n/32 with two slits.
+ *
+ * @param slitWidth Width of each slit, as a fraction of the box.
+ * @param slitSpacing Distance between the slit centres, as a fraction of the box.
+ */
+Geometry slitGeometry(double slitWidth, double slitSpacing);
+
+/**
+ * @brief Parses a geometry description.
+ *
+ * @param text Contents of a geometry file.
+ * @param directory Directory bitmap paths are relative to.
+ * @param geometry Receives the shapes.
+ * @param error Receives a message naming the offending line on failure.
+ * @return false if the description is invalid or a bitmap cannot be read.
+ */
+bool parseGeometry(const std::string& text, const std::string& directory, Geometry& geometry, std::string& error);
+
+/**
+ * @brief Reads and parses a geometry file.
+ *
+ * @param path Path of the geometry file.
+ * @param geometry Receives the shapes.
+ * @param error Receives a message on failure.
+ */
+bool readGeometry(const std::string& path, Geometry& geometry, std::string& error);
+
+/**
+ * @brief Returns the directory of a path, "." if it has none.
+ */
+std::string directoryOf(const std::string& path);
+
+/**
+ * @brief Rasterizes global rows [firstRow, firstRow + rows) of an n x n grid.
+ *
+ * @param geometry Shapes of the geometry.
+ * @param n Grid size.
+ * @param firstRow First global row, at least 0.
+ * @param rows Number of rows, at most n - firstRow.
+ * @param mask Receives the walls, row by row.
+ * @param offset Index of the first cell of row firstRow in mask.
+ */
+void rasterizeRows(const Geometry& geometry, int n, int firstRow, int rows, std::vector<bool>& mask, size_t offset = 0);
+
+#endif // GEOMETRY_H
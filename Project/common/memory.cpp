@@ -0,0 +1,97 @@
+/**
+ * @file memory.cpp
+ * @brief Implementation of the memory accounting declared in memory.h.
+ */
+
+#include "memory.h"
+#include <cstdio>
+#include <cstring>
+
+size_t nestedDoubleBytes(size_t rows, size_t cols) {
+    return sizeof(std::vector<std::vector<double>>) + rows * (sizeof(std::vector<double>) + cols * sizeof(double));
+}
+
+size_t nestedMaskBytes(size_t rows, size_t cols) {
+    // Bit vectors allocate whole words
+    size_t wordBits = 8 * sizeof(unsigned long);
+    size_t rowBytes = (cols + wordBits - 1) / wordBits * sizeof(unsigned long);
+    return sizeof(std::vector<std::vector<bool>>) + rows * (sizeof(std::vector<bool>) + rowBytes);
+}
+
+size_t flatDoubleBytes(size_t rows, size_t cols) {
+    return sizeof(std::vector<double>) + rows * cols * sizeof(double);
+}
+
+size_t flatMaskBytes(size_t rows, size_t cols) {
+    size_t wordBits = 8 * sizeof(unsigned long);
+    return sizeof(std::vector<bool>) + (rows * cols + wordBits - 1) / wordBits * sizeof(unsigned long);
+}
+
+/**
+ * @brief Reads a "<key>: <value> kB" line from a file in /proc.
+ *
+ * @return The value in bytes, or 0 if the key was not found.
+ */
+static size_t readProcKilobytes(const char* path, const char* key) {
+    FILE* file = std::fopen(path, "r");
+    if (file == nullptr) {
+        return 0;
+    }
+    char line[256];
+    size_t keyLength = std::strlen(key);
+    unsigned long long kilobytes = 0;
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        if (std::strncmp(line, key, keyLength) == 0 && line[keyLength] == ':') {
+            std::sscanf(line + keyLength + 1, "%llu", &kilobytes);
+            break;
+        }
+    }
+    std::fclose(file);
+    return static_cast<size_t>(kilobytes) * 1024;
+}
+
+size_t peakResidentBytes() {
+    return readProcKilobytes("/proc/self/status", "VmHWM");
+}
+
+size_t nodeMemoryBytes() {
+    return readProcKilobytes("/proc/meminfo", "MemTotal");
+}
+
+void MemoryReport::add(const std::string& name, size_t fieldBytes) {
+    names.push_back(name);
+    bytes.push_back(fieldBytes);
+}
+
+size_t MemoryReport::total() const {
+    size_t sum = 0;
+    for (size_t f = 0; f < bytes.size(); ++f) {
+        sum += bytes[f];
+    }
+    return sum;
+}
+
+void MemoryReport::print(std::ostream& out, const std::string& title, size_t cells) const {
+    char line[128];
+    out << title << "\n";
+    for (size_t f = 0; f < names.size(); ++f) {
+        std::snprintf(line, sizeof(line), "  %-12s %14.3f MiB\n", names[f].c_str(), bytes[f] / 1048576.0);
+        out << line;
+    }
+    std::snprintf(line, sizeof(line), "  %-12s %14.3f MiB, %.2f bytes per cell\n", "total", total() / 1048576.0,
+                  cells > 0 ? static_cast<double>(total()) / cells : 0.0);
+    out << line;
+
+    size_t node = nodeMemoryBytes();
+    if (node > 0) {
+        std::snprintf(line, sizeof(line), "  %-12s %14.3f MiB, %.1f%% used by the fields\n", "node", node / 1048576.0,
+                      100.0 * total() / node);
+        out << line;
+    }
+}
+
+void printResidentMemory(std::ostream& out) {
+    char line[128];
+    std::snprintf(line, sizeof(line), "Peak RSS: %.3f MiB\n", peakResidentBytes() / 1048576.0);
+    out << line;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file memory.h
+ * @brief Accounting of the memory used by the solver fields.
+ *
+ * The bytes of each field are counted from the capacity of its containers,
+ * including the per-row vector headers of the nested layouts, and compared
+ * with the peak resident set size reported by the kernel. The same layouts
+ * can be projected for any grid size before anything is allocated, so runs
+ * can be sized to the memory of a node.
+ */
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Returns the bytes held by a vector, including its header.
+ */
+template <typename T>
+size_t bytesOf(const std::vector<T>& v) {
+    return sizeof(v) + v.capacity() * sizeof(T);
+}
+
+/**
+ * @brief Returns the bytes held by a bit vector, including its header.
+ */
+inline size_t bytesOf(const std::vector<bool>& v) {
+    return sizeof(v) + (v.capacity() + 7) / 8;
+}
+
+/**
+ * @brief Returns the bytes held by a vector of rows, including every row header.
+ */
+template <typename T>
+size_t bytesOf(const std::vector<std::vector<T>>& v) {
+    size_t bytes = sizeof(v) + (v.capacity() - v.size()) * sizeof(std::vector<T>);
+    for (size_t i = 0; i < v.size(); ++i) {
+        bytes += bytesOf(v[i]);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Returns the bytes of a rows x cols field of doubles stored as a vector of rows.
+ */
+size_t nestedDoubleBytes(size_t rows, size_t cols);
+
+/**
+ * @brief Returns the bytes of a rows x cols mask stored as a vector of bit vectors.
+ */
+size_t nestedMaskBytes(size_t rows, size_t cols);
+
+/**
+ * @brief Returns the bytes of a rows x cols field of doubles stored in one vector.
+ */
+size_t flatDoubleBytes(size_t rows, size_t cols);
+
+/**
+ * @brief Returns the bytes of a rows x cols mask stored in one bit vector.
+ */
+size_t flatMaskBytes(size_t rows, size_t cols);
+
+/**
+ * @brief Returns the peak resident set size of the process (VmHWM), or 0 if unknown.
+ */
+size_t peakResidentBytes();
+
+/**
+ * @brief Returns the total memory of the node (MemTotal), or 0 if unknown.
+ */
+size_t nodeMemoryBytes();
+
+/**
+ * @brief Per-field memory usage of one solver.
+ */
+class MemoryReport {
+public:
+    /**
+     * @brief Adds a field.
+     *
+     * @param name Field name.
+     * @param bytes Bytes held by the field.
+     */
+    void add(const std::string& name, size_t bytes);
+
+    /**
+     * @brief Returns the bytes of all fields.
+     */
+    size_t total() const;
+
+    /**
+     * @brief Prints the bytes per field, the total and the bytes per grid cell.
+     *
+     * @param out Output stream.
+     * @param title Heading of the report.
+     * @param cells Number of grid cells the fields hold.
+     */
+    void print(std::ostream& out, const std::string& title, size_t cells) const;
+
+private:
+    std::vector<std::string> names;
+    std::vector<size_t> bytes;
+};
+
+/**
+ * @brief Prints the peak resident set size and the node memory.
+ *
+ * @param out Output stream.
+ */
+void printResidentMemory(std::ostream& out);
+
+#endif // MEMORY_H
@@ -0,0 +1,205 @@
+/**
+ * @file metrics.cpp
+ * @brief Implementation of the memory-mapped metrics declared in metrics.h.
+ */
+
+#include "metrics.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// The mapping is shared between processes, so the atomics must not use locks
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "8-byte atomics must be lock-free");
+
+/**
+ * @brief Indices of the values in the file.
+ */
+enum MetricValue {
+    VALUE_STEP,
+    VALUE_TIME,
+    VALUE_END_TIME,
+    VALUE_STEP_RATE,
+    VALUE_ENERGY,
+    VALUE_COMPUTE,
+    VALUE_WAIT,
+    VALUE_IMBALANCE,
+    VALUE_UPDATED,
+    VALUE_FINISHED,
+    NUM_VALUES
+};
+
+/**
+ * @brief Layout of a metrics file.
+ */
+struct MetricsLayout {
+    char magic[8];
+    uint32_t version;
+    int32_t rank;
+    int32_t ranks;
+    int32_t pid;
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> values[NUM_VALUES];
+};
+
+static const char metricsMagic[8] = { 'W', 'A', 'V', 'E', 'M', 'T', 'R', '1' };
+static const uint32_t metricsVersion = 1;
+
+static uint64_t bits(double value) {
+    uint64_t raw;
+    std::memcpy(&raw, &value, sizeof(raw));
+    return raw;
+}
+
+static double fromBits(uint64_t raw) {
+    double value;
+    std::memcpy(&value, &raw, sizeof(value));
+    return value;
+}
+
+MetricsWriter::MetricsWriter() : layout(nullptr), lastStep(0) {}
+
+MetricsWriter::~MetricsWriter() {
+    if (layout != nullptr) {
+        munmap(layout, sizeof(MetricsLayout));
+    }
+}
+
+bool MetricsWriter::open(const std::string& path, int rank, int ranks, double endTime) {
+    if (layout != nullptr) {
+        munmap(layout, sizeof(MetricsLayout));
+        layout = nullptr;
+    }
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    void* mapping = MAP_FAILED;
+    if (ftruncate(fd, sizeof(MetricsLayout)) == 0) {
+        mapping = mmap(nullptr, sizeof(MetricsLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    layout = new (mapping) MetricsLayout;
+    layout->version = metricsVersion;
+    layout->rank = rank;
+    layout->ranks = ranks;
+    layout->pid = static_cast<int32_t>(getpid());
+    layout->sequence.store(0, std::memory_order_relaxed);
+    for (int v = 0; v < NUM_VALUES; ++v) {
+        layout->values[v].store(0, std::memory_order_relaxed);
+    }
+    layout->values[VALUE_END_TIME].store(bits(endTime), std::memory_order_relaxed);
+
+    // Readers only accept the file once the magic is in place
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(layout->magic, metricsMagic, sizeof(metricsMagic));
+
+    lastStep = 0;
+    lastUpdate = std::chrono::steady_clock::now();
+    return true;
+}
+
+bool MetricsWriter::isOpen() const {
+    return layout != nullptr;
+}
+
+void MetricsWriter::publish(const MetricsSample& sample) {
+    write(sample, false);
+}
+
+void MetricsWriter::finish(const MetricsSample& sample) {
+    write(sample, true);
+}
+
+void MetricsWriter::write(const MetricsSample& sample, bool finished) {
+    if (layout == nullptr) {
+        return;
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(now - lastUpdate).count();
+    // A step count below the previous one starts a new run in the same file
+    long long previous = sample.step >= lastStep ? lastStep : 0;
+    double stepRate = seconds > 0.0 ? (sample.step - previous) / seconds : 0.0;
+    if (finished && sample.step == lastStep) {
+        // Nothing happened since the last update; keep its rate
+        stepRate = fromBits(layout->values[VALUE_STEP_RATE].load(std::memory_order_relaxed));
+    }
+    lastStep = sample.step;
+    lastUpdate = now;
+    double updated = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    // Sequence lock: odd while writing, so readers retry instead of mixing two updates
+    uint64_t sequence = layout->sequence.load(std::memory_order_relaxed);
+    layout->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::atomic<uint64_t>* values = layout->values;
+    values[VALUE_STEP].store(static_cast<uint64_t>(sample.step), std::memory_order_relaxed);
+    values[VALUE_TIME].store(bits(sample.time), std::memory_order_relaxed);
+    values[VALUE_STEP_RATE].store(bits(stepRate), std::memory_order_relaxed);
+    values[VALUE_ENERGY].store(bits(sample.energy), std::memory_order_relaxed);
+    values[VALUE_COMPUTE].store(bits(sample.computeSeconds), std::memory_order_relaxed);
+    values[VALUE_WAIT].store(bits(sample.waitSeconds), std::memory_order_relaxed);
+    values[VALUE_IMBALANCE].store(bits(sample.imbalance), std::memory_order_relaxed);
+    values[VALUE_UPDATED].store(bits(updated), std::memory_order_relaxed);
+    values[VALUE_FINISHED].store(finished ? 1 : 0, std::memory_order_relaxed);
+
+    layout->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool readMetrics(const std::string& path, MetricsSnapshot& snapshot) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    void* mapping = MAP_FAILED;
+    if (lseek(fd, 0, SEEK_END) >= static_cast<off_t>(sizeof(MetricsLayout))) {
+        mapping = mmap(nullptr, sizeof(MetricsLayout), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const MetricsLayout* layout = static_cast<const MetricsLayout*>(mapping);
+    bool valid = std::memcmp(layout->magic, metricsMagic, sizeof(metricsMagic)) == 0
+              && layout->version == metricsVersion;
+    if (valid) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        snapshot.rank = layout->rank;
+        snapshot.ranks = layout->ranks;
+        snapshot.pid = layout->pid;
+
+        uint64_t raw[NUM_VALUES];
+        uint64_t before, after;
+        do {
+            before = layout->sequence.load(std::memory_order_acquire);
+            for (int v = 0; v < NUM_VALUES; ++v) {
+                raw[v] = layout->values[v].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = layout->sequence.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+
+        snapshot.endTime = fromBits(raw[VALUE_END_TIME]);
+        snapshot.updated = fromBits(raw[VALUE_UPDATED]);
+        snapshot.finished = raw[VALUE_FINISHED] != 0;
+        snapshot.sample.step = static_cast<long long>(raw[VALUE_STEP]);
+        snapshot.sample.time = fromBits(raw[VALUE_TIME]);
+        snapshot.sample.stepRate = fromBits(raw[VALUE_STEP_RATE]);
+        snapshot.sample.energy = fromBits(raw[VALUE_ENERGY]);
+        snapshot.sample.computeSeconds = fromBits(raw[VALUE_COMPUTE]);
+        snapshot.sample.waitSeconds = fromBits(raw[VALUE_WAIT]);
+        snapshot.sample.imbalance = fromBits(raw[VALUE_IMBALANCE]);
+    }
+    munmap(mapping, sizeof(MetricsLayout));
+    return valid;
+}
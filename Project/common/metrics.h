@@ -0,0 +1,111 @@
+/**
+ * @file metrics.h
+ * @brief Live metrics of a running solver in a memory-mapped file.
+ *
+ * A solver maps a small file of fixed layout and publishes its progress every
+ * few steps: step, simulated time, step rate, field energy, compute and wait
+ * time and thread imbalance. Every value is an 8-byte atomic in the mapping,
+ * written with plain atomic stores under a sequence counter, so readers in
+ * other processes get a consistent snapshot without locks and never stall the
+ * solver. The MPI solver writes one file per rank (path.rank).
+ *
+ * File layout, little-endian:
+ * - char[8] magic "WAVEMTR1", uint32 version, int32 rank, int32 ranks, int32 pid
+ * - uint64 sequence, odd while an update is in progress
+ * - uint64 values[]: step, time, end time, step rate, energy, compute seconds,
+ *   wait seconds, imbalance, update time (Unix seconds) and finished flag;
+ *   the step is an integer, all others are doubles stored by bit pattern
+ */
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <chrono>
+#include <string>
+
+/**
+ * @brief Values published by a solver.
+ */
+struct MetricsSample {
+    long long step;        /**< Steps taken */
+    double time;           /**< Simulated time */
+    double stepRate;       /**< Steps per second since the previous update; set by the writer */
+    double energy;         /**< Sum of U^2 over the cells owned by the process */
+    double computeSeconds; /**< Time spent in the stencil */
+    double waitSeconds;    /**< Time spent waiting for other ranks */
+    double imbalance;      /**< Largest over mean work of the threads, 1 if single-threaded */
+};
+
+/**
+ * @brief Consistent copy of a metrics file.
+ */
+struct MetricsSnapshot {
+    int rank;
+    int ranks;
+    int pid;
+    double endTime;        /**< Simulated end time */
+    double updated;        /**< Unix time of the latest update in seconds */
+    bool finished;         /**< The solver has completed its run */
+    MetricsSample sample;
+};
+
+struct MetricsLayout;
+
+/**
+ * @brief Publishes metrics of one process into a memory-mapped file.
+ */
+class MetricsWriter {
+public:
+    MetricsWriter();
+
+    /**
+     * @brief Unmaps the file; its last contents stay readable.
+     */
+    ~MetricsWriter();
+
+    MetricsWriter(const MetricsWriter&) = delete;
+    MetricsWriter& operator=(const MetricsWriter&) = delete;
+
+    /**
+     * @brief Creates and maps the metrics file.
+     *
+     * @param path File to create or overwrite.
+     * @param rank Rank of the process.
+     * @param ranks Number of ranks of the run.
+     * @param endTime Simulated end time.
+     * @return false if the file could not be created.
+     */
+    bool open(const std::string& path, int rank, int ranks, double endTime);
+
+    /**
+     * @brief Returns whether a file is mapped.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Publishes a sample; the step rate is computed from the previous one.
+     */
+    void publish(const MetricsSample& sample);
+
+    /**
+     * @brief Publishes a final sample and marks the run as finished.
+     */
+    void finish(const MetricsSample& sample);
+
+private:
+    void write(const MetricsSample& sample, bool finished);
+
+    MetricsLayout* layout;
+    long long lastStep;
+    std::chrono::steady_clock::time_point lastUpdate;
+};
+
+/**
+ * @brief Reads a consistent snapshot of a metrics file without locking.
+ *
+ * @param path Metrics file.
+ * @param snapshot Receives the values.
+ * @return false if the file is missing or not a metrics file.
+ */
+bool readMetrics(const std::string& path, MetricsSnapshot& snapshot);
+
+#endif // METRICS_H
@@ -0,0 +1,39 @@
+/**
+ * @file parameter_grid.cpp
+ * @brief Implementation of the grid file reader declared in parameter_grid.h.
+ */
+
+#include "parameter_grid.h"
+#include <fstream>
+#include <sstream>
+
+bool readParameterLines(const std::string& path, std::vector<ParameterLine>& lines) {
+    std::ifstream in(path.c_str());
+    if (!in) {
+        std::cerr << "Could not open " << path << std::endl;
+        return false;
+    }
+
+    lines.clear();
+    std::string text;
+    int number = 0;
+    while (std::getline(in, text)) {
+        ++number;
+        text = text.substr(0, text.find('#'));
+        std::istringstream fields(text);
+        ParameterLine line;
+        line.line = number;
+        if (!(fields >> line.name)) {
+            continue;
+        }
+
+        double value;
+        while (fields >> value) {
+            line.values.push_back(value);
+        }
+        // Reading stops early at a token that is not a number
+        line.numeric = fields.eof();
+        lines.push_back(line);
+    }
+    return true;
+}
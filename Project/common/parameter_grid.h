@@ -0,0 +1,87 @@
+/**
+ * @file parameter_grid.h
+ * @brief Reader of the parameter grid files of the sweep and the MPI ensembles.
+ *
+ * A grid file lists one parameter per line followed by its values; '#' starts
+ * a comment. Every combination of values is one point of the grid, with the
+ * parameter of the last line varying fastest, and parameters that are not
+ * listed keep their default. A line that names an unknown parameter, has no
+ * values or a value that is not a number rejects the whole file, reported with
+ * its line number, so a typo never silently shrinks or empties the grid.
+ */
+#ifndef PARAMETER_GRID_H
+#define PARAMETER_GRID_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One parameter of a grid file and its values.
+ */
+struct ParameterLine {
+    std::string name;
+    std::vector<double> values; /**< Values up to the first one that is not a number */
+    bool numeric;               /**< Whether every value was a number */
+    int line;                   /**< Line number in the file, from 1 */
+};
+
+/**
+ * @brief Reads the parameter lines of a grid file.
+ *
+ * @param path Path of the grid file.
+ * @param lines Receives the non-empty lines in the order of the file.
+ * @return false if the file cannot be read.
+ */
+bool readParameterLines(const std::string& path, std::vector<ParameterLine>& lines);
+
+/**
+ * @brief Reads a grid file and expands it into all combinations.
+ *
+ * @param path Path of the grid file.
+ * @param defaults Parameters that are not listed.
+ * @param set Sets a parameter by name, returning false if the name is unknown.
+ * @param configs Receives one configuration per combination.
+ * @return false if the file cannot be read or has an invalid line.
+ */
+template <class Config>
+bool readParameterGrid(const std::string& path, const Config& defaults,
+                       bool (*set)(Config&, const std::string&, double), std::vector<Config>& configs) {
+    std::vector<ParameterLine> lines;
+    if (!readParameterLines(path, lines)) {
+        return false;
+    }
+
+    configs.assign(1, defaults);
+    for (size_t l = 0; l < lines.size(); ++l) {
+        const ParameterLine& line = lines[l];
+        Config probe = defaults;
+        const char* error = nullptr;
+        if (!set(probe, line.name, 0.0)) {
+            error = "unknown parameter ";
+        } else if (!line.numeric) {
+            error = "invalid value for ";
+        } else if (line.values.empty()) {
+            // A parameter without values would leave no combination at all
+            error = "no values for ";
+        }
+        if (error != nullptr) {
+            std::cerr << path << ": line " << line.line << ": " << error << line.name << std::endl;
+            return false;
+        }
+
+        std::vector<Config> expanded;
+        expanded.reserve(configs.size() * line.values.size());
+        for (size_t c = 0; c < configs.size(); ++c) {
+            for (size_t v = 0; v < line.values.size(); ++v) {
+                Config config = configs[c];
+                set(config, line.name, line.values[v]);
+                expanded.push_back(config);
+            }
+        }
+        configs.swap(expanded);
+    }
+    return true;
+}
+
+#endif // PARAMETER_GRID_H
@@ -0,0 +1,64 @@
+/**
+ * @file partition.cpp
+ * @brief Implementation of the row partitions declared in partition.h.
+ */
+
+#include "partition.h"
+#include <algorithm>
+
+/**
+ * @brief Returns the number of active interior cells of a row.
+ */
+static long activeCells(const std::vector<bool>& row) {
+    long count = 0;
+    for (size_t j = 1; j + 1 < row.size(); ++j) {
+        count += row[j] ? 0 : 1;
+    }
+    return count;
+}
+
+std::vector<int> balancedRowPartition(const std::vector<std::vector<bool>>& mask, int parts) {
+    int n = static_cast<int>(mask.size());
+    int first = 1;
+    int last = n - 1;
+
+    // prefix[k] holds the active cells of the rows first..first+k-1
+    std::vector<long> prefix(1, 0);
+    for (int i = first; i < last; ++i) {
+        prefix.push_back(prefix.back() + activeCells(mask[i]));
+    }
+    long total = prefix.back();
+
+    std::vector<int> bounds(parts + 1, first);
+    bounds[parts] = last;
+    for (int p = 1; p < parts; ++p) {
+        // Cut at the row boundary closest to an equal share of the work
+        long target = total * p / parts;
+        int k = static_cast<int>(std::lower_bound(prefix.begin(), prefix.end(), target) - prefix.begin());
+        if (k > 0 && target - prefix[k - 1] < prefix[k] - target) {
+            --k;
+        }
+        bounds[p] = std::max(bounds[p - 1], first + k);
+    }
+    return bounds;
+}
+
+std::vector<long> partitionWork(const std::vector<std::vector<bool>>& mask, const std::vector<int>& bounds) {
+    std::vector<long> work(bounds.size() - 1, 0);
+    for (size_t p = 0; p + 1 < bounds.size(); ++p) {
+        for (int i = bounds[p]; i < bounds[p + 1]; ++i) {
+            work[p] += activeCells(mask[i]);
+        }
+    }
+    return work;
+}
+
+double partitionImbalance(const std::vector<long>& work) {
+    long sum = 0;
+    long largest = 0;
+    for (size_t p = 0; p < work.size(); ++p) {
+        sum += work[p];
+        largest = std::max(largest, work[p]);
+    }
+    return sum > 0 ? static_cast<double>(largest) * work.size() / sum : 1.0;
+}
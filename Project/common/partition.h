@@ -0,0 +1,40 @@
+/**
+ * @file partition.h
+ * @brief Row partitions of the grid with equal work per thread.
+ *
+ * Wall cells are skipped by the stencil, so splitting the iterations evenly
+ * leaves threads with wall-heavy bands idle at the barrier. These functions
+ * split the interior rows into contiguous bands with about the same number
+ * of active (non-wall) cells, computed once from the mask and reused every
+ * step. Contiguous bands also keep every row on a single thread.
+ */
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <vector>
+
+/**
+ * @brief Splits the interior rows 1..n-2 into bands with equal active cells.
+ *
+ * @param mask Grid mask, true for wall and boundary cells.
+ * @param parts Number of bands.
+ * @return parts + 1 row boundaries; band p holds rows [bounds[p], bounds[p+1]).
+ */
+std::vector<int> balancedRowPartition(const std::vector<std::vector<bool>>& mask, int parts);
+
+/**
+ * @brief Returns the number of active interior cells in each band.
+ *
+ * @param mask Grid mask.
+ * @param bounds Row boundaries from balancedRowPartition().
+ */
+std::vector<long> partitionWork(const std::vector<std::vector<bool>>& mask, const std::vector<int>& bounds);
+
+/**
+ * @brief Returns the imbalance of a partition: the largest band's work over the mean.
+ *
+ * @param work Active cells per band from partitionWork().
+ */
+double partitionImbalance(const std::vector<long>& work);
+
+#endif // PARTITION_H
@@ -0,0 +1,112 @@
+/**
+ * @file probes.cpp
+ * @brief Implementation of the point probes declared in probes.h.
+ */
+
+#include "probes.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+
+bool readProbes(const std::string& path, std::vector<Probe>& probes) {
+    std::ifstream in(path.c_str());
+    if (!in) {
+        return false;
+    }
+    Probe probe;
+    while (in >> probe.x >> probe.y) {
+        probes.push_back(probe);
+    }
+    return true;
+}
+
+/**
+ * @brief Splits a coordinate into the lower cell index and the weight of the upper cell.
+ *
+ * Cell centres lie at (k + 0.5) * dx. Coordinates outside the outermost centres
+ * are clamped to them.
+ */
+static void locate(double coordinate, double dx, int N, int& index, double& weight) {
+    double position = coordinate / dx - 0.5;
+    position = std::min(std::max(position, 0.0), static_cast<double>(N - 1));
+    index = std::min(static_cast<int>(std::floor(position)), N - 2);
+    weight = position - index;
+}
+
+ProbeRecorder::ProbeRecorder(const std::vector<Probe>& probes, int N, double boxsize, double dt,
+                             int firstRow, int lastRow, int blockSteps)
+    : allProbes(probes), dt(dt), blockSteps(blockSteps), count(0), firstStep(0), file(nullptr) {
+    double dx = boxsize / N;
+    for (size_t p = 0; p < probes.size(); ++p) {
+        Stencil s;
+        double wi, wj;
+        locate(probes[p].y, dx, N, s.i, wi);
+        locate(probes[p].x, dx, N, s.j, wj);
+        if (s.i < firstRow || s.i > lastRow) {
+            continue;
+        }
+        s.probe = static_cast<int>(p);
+        s.w00 = (1.0 - wi) * (1.0 - wj);
+        s.w01 = (1.0 - wi) * wj;
+        s.w10 = wi * (1.0 - wj);
+        s.w11 = wi * wj;
+        stencils.push_back(s);
+    }
+    buffer.resize(stencils.size() * blockSteps);
+}
+
+ProbeRecorder::~ProbeRecorder() {
+    flush();
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+}
+
+bool ProbeRecorder::open(const std::string& path) {
+    file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        std::cerr << "Could not open " << path << " for writing" << std::endl;
+        return false;
+    }
+    const char magic[4] = { 'W', 'P', 'R', 'B' };
+    int32_t version = 1;
+    int32_t numProbes = static_cast<int32_t>(allProbes.size());
+    std::fwrite(magic, 1, sizeof(magic), file);
+    std::fwrite(&version, sizeof(version), 1, file);
+    std::fwrite(&numProbes, sizeof(numProbes), 1, file);
+    std::fwrite(&dt, sizeof(dt), 1, file);
+    for (size_t p = 0; p < allProbes.size(); ++p) {
+        std::fwrite(&allProbes[p].x, sizeof(double), 1, file);
+        std::fwrite(&allProbes[p].y, sizeof(double), 1, file);
+    }
+    return true;
+}
+
+void ProbeRecorder::endStep() {
+    ++count;
+    if (count == blockSteps) {
+        flush();
+    }
+}
+
+void ProbeRecorder::flush() {
+    if (count == 0) {
+        return;
+    }
+    if (file != nullptr) {
+        for (size_t p = 0; p < stencils.size(); ++p) {
+            int32_t probe = stencils[p].probe;
+            int32_t samples = count;
+            int64_t first = firstStep;
+            std::fwrite(&probe, sizeof(probe), 1, file);
+            std::fwrite(&samples, sizeof(samples), 1, file);
+            std::fwrite(&first, sizeof(first), 1, file);
+            std::fwrite(&buffer[p * blockSteps], sizeof(double), count, file);
+        }
+        std::fflush(file);
+    }
+    firstStep += count;
+    count = 0;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file probes.h
+ * @brief Point probes that record the field at chosen locations every step.
+ *
+ * A probe is a point in physical coordinates. Off-grid probes are interpolated
+ * bilinearly from the four surrounding cell centres. Samples are kept in memory
+ * and written in large binary blocks whenever the buffers are full and when the
+ * recorder is closed.
+ *
+ * File layout (native byte order):
+ *  - header: char[4] "WPRB", int32 version, int32 numProbes, double dt,
+ *    followed by numProbes pairs of doubles (x, y)
+ *  - blocks: int32 probe, int32 count, int64 firstStep, double values[count]
+ *
+ * Sample k of a block belongs to time step firstStep + k, i.e. time
+ * (firstStep + k) * dt.
+ */
+#ifndef PROBES_H
+#define PROBES_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Location of a probe in physical coordinates.
+ *
+ * x runs along the columns and y along the rows of the grid.
+ */
+struct Probe {
+    double x;
+    double y;
+};
+
+/**
+ * @brief Reads probe locations from a text file with one "x y" pair per line.
+ *
+ * @param path Path of the probe file.
+ * @param probes Receives the probe locations.
+ * @return false if the file could not be read.
+ */
+bool readProbes(const std::string& path, std::vector<Probe>& probes);
+
+/**
+ * @brief Samples probes every step and writes them to a binary file in blocks.
+ *
+ * The recorder only keeps the probes whose interpolation stencil starts in the
+ * rows [firstRow, lastRow], so every MPI rank can record the probes it owns.
+ * Buffers are stored probe by probe, so a static partition of the probes over
+ * OpenMP threads gives every thread its own contiguous buffer.
+ */
+class ProbeRecorder {
+public:
+    /**
+     * @brief Creates a recorder for the probes owned by a range of rows.
+     *
+     * @param probes Locations of all probes.
+     * @param N Number of grid cells per dimension.
+     * @param boxsize Size of the computational domain.
+     * @param dt Time step, stored in the file header.
+     * @param firstRow First global row owned by the caller.
+     * @param lastRow Last global row owned by the caller (inclusive).
+     * @param blockSteps Number of steps buffered before a block is written.
+     */
+    ProbeRecorder(const std::vector<Probe>& probes, int N, double boxsize, double dt,
+                  int firstRow, int lastRow, int blockSteps);
+
+    /**
+     * @brief Writes any buffered samples and closes the file.
+     */
+    ~ProbeRecorder();
+
+    /**
+     * @brief Opens the output file and writes the header.
+     *
+     * @param path Path of the output file.
+     * @return false if the file could not be opened.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Returns the number of probes owned by the recorder.
+     */
+    int size() const { return static_cast<int>(stencils.size()); }
+
+    /**
+     * @brief Returns whether the recorder owns no probes.
+     */
+    bool empty() const { return stencils.empty(); }
+
+    /**
+     * @brief Records the current value of one owned probe.
+     *
+     * @param p Index of the owned probe, 0 <= p < size().
+     * @param field Callable returning the field value at global (row, column).
+     */
+    template <class Field>
+    void sample(int p, const Field& field) {
+        const Stencil& s = stencils[p];
+        double value = s.w00 * field(s.i, s.j) + s.w01 * field(s.i, s.j + 1)
+                     + s.w10 * field(s.i + 1, s.j) + s.w11 * field(s.i + 1, s.j + 1);
+        buffer[static_cast<size_t>(p) * blockSteps + count] = value;
+    }
+
+    /**
+     * @brief Records the current value of all owned probes.
+     *
+     * @param field Callable returning the field value at global (row, column).
+     */
+    template <class Field>
+    void sampleAll(const Field& field) {
+        for (int p = 0; p < size(); ++p) {
+            sample(p, field);
+        }
+    }
+
+    /**
+     * @brief Completes the samples of one step, writing a block if the buffers are full.
+     */
+    void endStep();
+
+    /**
+     * @brief Writes the buffered samples of all probes as blocks.
+     */
+    void flush();
+
+private:
+    /**
+     * @brief Bilinear interpolation stencil of one probe.
+     */
+    struct Stencil {
+        int probe;              /**< Global index of the probe */
+        int i, j;               /**< Row and column of the lower-left cell centre */
+        double w00, w01, w10, w11;
+    };
+
+    std::vector<Probe> allProbes;
+    std::vector<Stencil> stencils;
+    std::vector<double> buffer;
+    double dt;
+    int blockSteps;
+    int count;
+    long long firstStep;
+    FILE* file;
+
+    ProbeRecorder(const ProbeRecorder&);
+    ProbeRecorder& operator=(const ProbeRecorder&);
+};
+
+#endif // PROBES_H
@@ -0,0 +1,101 @@
+/**
+ * @file trace.cpp
+ * @brief Implementation of the tracing declared in trace.h.
+ */
+
+#include "trace.h"
+
+#ifdef WAVE_TRACE
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    int64_t start;
+    int64_t end;
+};
+
+struct TraceBuffer {
+    int tid;
+    std::vector<TraceEvent> events;
+};
+
+// Buffers are owned by the registry and outlive their threads, so events of
+// finished threads can still be written
+std::mutex registryLock;
+std::vector<TraceBuffer*> registry;
+thread_local TraceBuffer* localBuffer = nullptr;
+
+TraceBuffer* registerThread() {
+    TraceBuffer* buffer = new TraceBuffer;
+    buffer->events.reserve(1 << 16);
+    std::lock_guard<std::mutex> guard(registryLock);
+    buffer->tid = static_cast<int>(registry.size());
+    registry.push_back(buffer);
+    return buffer;
+}
+
+} // namespace
+
+int64_t traceNow() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void traceRecord(const char* name, int64_t start, int64_t end) {
+    if (localBuffer == nullptr) {
+        localBuffer = registerThread();
+    }
+    TraceEvent event = { name, start, end };
+    localBuffer->events.push_back(event);
+}
+
+std::string traceEvents(int pid, const std::string& processName) {
+    std::lock_guard<std::mutex> guard(registryLock);
+    std::string json;
+    char line[256];
+
+    std::snprintf(line, sizeof(line), "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"%s\"}}",
+                  pid, processName.c_str());
+    json += line;
+    for (size_t b = 0; b < registry.size(); ++b) {
+        const TraceBuffer& buffer = *registry[b];
+        std::snprintf(line, sizeof(line),
+                      ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}",
+                      pid, buffer.tid, buffer.tid);
+        json += line;
+
+        // Timestamps and durations are in microseconds
+        for (size_t e = 0; e < buffer.events.size(); ++e) {
+            const TraceEvent& event = buffer.events[e];
+            std::snprintf(line, sizeof(line),
+                          ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                          event.name, pid, buffer.tid, event.start / 1e3, (event.end - event.start) / 1e3);
+            json += line;
+        }
+    }
+    return json;
+}
+
+void traceClear() {
+    std::lock_guard<std::mutex> guard(registryLock);
+    for (size_t b = 0; b < registry.size(); ++b) {
+        registry[b]->events.clear();
+    }
+}
+
+bool traceWrite(const std::string& path, const std::string& events) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    std::fprintf(file, "{\"traceEvents\":[\n%s\n],\"displayTimeUnit\":\"ms\"}\n", events.c_str());
+    return std::fclose(file) == 0;
+}
+
+#endif // WAVE_TRACE
@@ -0,0 +1,97 @@
+/**
+ * @file trace.h
+ * @brief Timeline tracing of solver phases in the Chrome Trace Event format.
+ *
+ * Events are recorded into one buffer per thread, so recording never takes a
+ * lock; a thread only registers its buffer once, on its first event. The
+ * events are written as complete ("X") events with one track per thread and
+ * one process per rank, and can be opened in chrome://tracing or Perfetto.
+ *
+ * Tracing is compiled in only when WAVE_TRACE is defined (make TRACE=1).
+ * Otherwise TRACE_SCOPE expands to nothing and the functions below are empty
+ * inline stubs, so the instrumentation costs nothing.
+ */
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstdint>
+#include <string>
+
+#ifdef WAVE_TRACE
+
+/** @brief Whether tracing was compiled in. */
+const bool traceEnabled = true;
+
+/**
+ * @brief Returns the current time in nanoseconds of the monotonic clock.
+ *
+ * The clock is shared by all processes on a node, so ranks line up.
+ */
+int64_t traceNow();
+
+/**
+ * @brief Records an event of the calling thread.
+ *
+ * @param name Event name; must outlive the trace (string literals).
+ * @param start Start time from traceNow().
+ * @param end End time from traceNow().
+ */
+void traceRecord(const char* name, int64_t start, int64_t end);
+
+/**
+ * @brief Returns the events of all threads as comma-separated JSON objects.
+ *
+ * @param pid Process id of the events, e.g. the MPI rank.
+ * @param processName Name shown for the process track.
+ */
+std::string traceEvents(int pid, const std::string& processName);
+
+/**
+ * @brief Drops the events recorded so far, e.g. once a run's trace is written.
+ *
+ * The buffers stay registered and keep their capacity. No other thread may
+ * record while the events are dropped.
+ */
+void traceClear();
+
+/**
+ * @brief Writes events from traceEvents() as a Chrome trace file.
+ *
+ * @return false if the file could not be written.
+ */
+bool traceWrite(const std::string& path, const std::string& events);
+
+/**
+ * @brief Records the lifetime of a scope as an event.
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) : name(name), start(traceNow()) {}
+    ~TraceScope() { traceRecord(name, start, traceNow()); }
+
+private:
+    const char* name;
+    int64_t start;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+/** @brief Records the rest of the enclosing scope as an event. */
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+
+#else
+
+const bool traceEnabled = false;
+
+inline int64_t traceNow() { return 0; }
+inline void traceRecord(const char*, int64_t, int64_t) {}
+inline std::string traceEvents(int, const std::string&) { return std::string(); }
+inline void traceClear() {}
+inline bool traceWrite(const std::string&, const std::string&) { return false; }
+
+#define TRACE_SCOPE(name)
+
+#endif // WAVE_TRACE
+
+#endif // TRACE_H
@@ -0,0 +1,159 @@
+/**
+ * @file video.cpp
+ * @brief Implementation of the YUV4MPEG2 writer declared in video.h.
+ */
+
+#include "video.h"
+#include "trace.h"
+#include <algorithm>
+#include <iostream>
+
+VideoWriter::VideoWriter(int N, int scale, int fps, int queueDepth)
+    : N(N), scale(std::max(1, scale)), size(N / std::max(1, scale)), fps(fps),
+      queueDepth(std::max(1, queueDepth)), file(nullptr), ownsFile(false), stopping(false) {
+    value.resize(static_cast<size_t>(size) * size);
+    wall.resize(static_cast<size_t>(size) * size);
+}
+
+VideoWriter::~VideoWriter() {
+    close();
+}
+
+bool VideoWriter::open(const std::string& path) {
+    if (path == "-") {
+        file = stdout;
+        ownsFile = false;
+    } else {
+        file = std::fopen(path.c_str(), "wb");
+        ownsFile = true;
+        if (file == nullptr) {
+            std::cerr << "Could not open " << path << " for writing" << std::endl;
+            return false;
+        }
+    }
+    std::fprintf(file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444 XCOLORRANGE=FULL\n", size, size, fps);
+    stopping = false;
+    writer = std::thread(&VideoWriter::writerLoop, this);
+    return true;
+}
+
+void VideoWriter::addFrame(const std::vector<std::vector<double>>& U, const std::vector<std::vector<bool>>& mask) {
+    if (file == nullptr) {
+        return;
+    }
+
+    // Box-average the field and the wall fraction. Image rows follow the grid
+    // rows, so every thread reads and writes contiguous rows.
+    const float norm = 1.0f / (scale * scale);
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < size; ++y) {
+        float* rowValue = &value[static_cast<size_t>(y) * size];
+        float* rowWall = &wall[static_cast<size_t>(y) * size];
+        for (int x = 0; x < size; ++x) {
+            rowValue[x] = 0.0f;
+            rowWall[x] = 0.0f;
+        }
+        for (int i = y * scale; i < (y + 1) * scale; ++i) {
+            const std::vector<double>& row = U[i];
+            const std::vector<bool>& rowMask = mask[i];
+            for (int j = 0; j < size * scale; ++j) {
+                rowValue[j / scale] += static_cast<float>(row[j]);
+                rowWall[j / scale] += rowMask[j] ? 1.0f : 0.0f;
+            }
+        }
+        for (int x = 0; x < size; ++x) {
+            rowValue[x] *= norm;
+            rowWall[x] *= norm;
+        }
+    }
+
+    queueFrame(value.data(), wall.data());
+}
+
+void VideoWriter::addFrame(const std::vector<float>& pixels, const std::vector<float>& walls) {
+    if (file == nullptr) {
+        return;
+    }
+    queueFrame(pixels.data(), walls.data());
+}
+
+void VideoWriter::queueFrame(const float* values, const float* walls) {
+    std::vector<unsigned char> frame;
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        changed.wait(guard, [this] { return pending.size() < queueDepth; });
+        if (!freeFrames.empty()) {
+            frame.swap(freeFrames.back());
+            freeFrames.pop_back();
+        }
+    }
+    const size_t pixels = static_cast<size_t>(size) * size;
+    frame.resize(3 * pixels);
+
+    // Colour map (v, v, 255 - v) darkened by the wall fraction, converted to full range YCbCr
+    unsigned char* Y = frame.data();
+    unsigned char* Cb = Y + pixels;
+    unsigned char* Cr = Cb + pixels;
+    const long long count = static_cast<long long>(pixels);
+    #pragma omp parallel for simd schedule(static)
+    for (long long p = 0; p < count; ++p) {
+        float v = std::min(255.0f, std::max(0.0f, 127.5f * (values[p] + 1.0f)));
+        float open = 1.0f - walls[p];
+        float r = v * open;
+        float b = (255.0f - v) * open;
+        Y[p] = static_cast<unsigned char>(0.886f * r + 0.114f * b + 0.5f);
+        Cb[p] = static_cast<unsigned char>(std::min(255.0f, 128.0f - 0.5f * r + 0.5f * b + 0.5f));
+        Cr[p] = static_cast<unsigned char>(128.0f + 0.081312f * r - 0.081312f * b + 0.5f);
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        pending.push_back(std::vector<unsigned char>());
+        pending.back().swap(frame);
+    }
+    changed.notify_all();
+}
+
+void VideoWriter::writerLoop() {
+    std::unique_lock<std::mutex> guard(lock);
+    for (;;) {
+        changed.wait(guard, [this] { return stopping || !pending.empty(); });
+        if (pending.empty()) {
+            break;
+        }
+        std::vector<unsigned char> frame;
+        frame.swap(pending.front());
+        pending.pop_front();
+
+        // Write without holding the lock so the solver can convert the next frame
+        guard.unlock();
+        {
+            TRACE_SCOPE("write frame");
+            std::fputs("FRAME\n", file);
+            std::fwrite(frame.data(), 1, frame.size(), file);
+        }
+        guard.lock();
+
+        freeFrames.push_back(std::vector<unsigned char>());
+        freeFrames.back().swap(frame);
+        changed.notify_all();
+    }
+}
+
+void VideoWriter::close() {
+    if (file == nullptr) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    changed.notify_all();
+    writer.join();
+
+    std::fflush(file);
+    if (ownsFile) {
+        std::fclose(file);
+    }
+    file = nullptr;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file video.h
+ * @brief Streams simulation frames as raw YUV4MPEG2 video.
+ *
+ * Frames are colour mapped like the SFML viewer (walls black, the field from
+ * blue through grey to yellow) and optionally downscaled by box averaging.
+ * Image rows follow the grid rows, so the inflow boundary is at the top.
+ * The conversion runs as a parallel, vectorizable pass on the calling thread
+ * and the finished frames are written by a background thread, so the solver
+ * only waits when the writer falls more than a few frames behind.
+ *
+ * The output can be encoded offline, for example:
+ *   ffmpeg -i wave.y4m -c:v libx264 wave.mp4
+ */
+#ifndef VIDEO_H
+#define VIDEO_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Writes frames to a YUV4MPEG2 (4:4:4) file or to stdout.
+ */
+class VideoWriter {
+public:
+    /**
+     * @brief Creates a writer for N x N fields.
+     *
+     * @param N Number of grid cells per dimension.
+     * @param scale Downscaling factor; each pixel averages scale x scale cells.
+     * @param fps Frame rate stored in the stream header.
+     * @param queueDepth Maximum number of frames waiting for the writer thread.
+     */
+    VideoWriter(int N, int scale, int fps, int queueDepth = 3);
+
+    /**
+     * @brief Writes the remaining frames and stops the writer thread.
+     */
+    ~VideoWriter();
+
+    /**
+     * @brief Opens the output and starts the writer thread.
+     *
+     * @param path Output file, or "-" for stdout.
+     * @return false if the file could not be opened.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Returns true if the writer has been opened.
+     */
+    bool isOpen() const { return file != nullptr; }
+
+    /**
+     * @brief Converts a field to a frame and queues it for writing.
+     *
+     * Blocks only if queueDepth frames are already waiting.
+     *
+     * @param U Grid values.
+     * @param mask Grid mask, masked cells are drawn as walls.
+     */
+    void addFrame(const std::vector<std::vector<double>>& U, const std::vector<std::vector<bool>>& mask);
+
+    /**
+     * @brief Queues a frame whose pixels were box-averaged by the caller.
+     *
+     * Blocks only if queueDepth frames are already waiting.
+     *
+     * @param pixels Mean field value of every pixel, frameSize() x frameSize() row by row.
+     * @param walls Fraction of wall cells of every pixel, same layout.
+     */
+    void addFrame(const std::vector<float>& pixels, const std::vector<float>& walls);
+
+    /**
+     * @brief Waits for all queued frames, stops the writer thread and closes the output.
+     */
+    void close();
+
+    /**
+     * @brief Returns the width (and height) of the frames in pixels.
+     */
+    int frameSize() const { return size; }
+
+private:
+    void queueFrame(const float* values, const float* walls);
+    void writerLoop();
+
+    int N;
+    int scale;
+    int size;
+    int fps;
+    size_t queueDepth;
+    FILE* file;
+    bool ownsFile;
+
+    std::vector<float> value;   /**< Downscaled field of the frame being converted */
+    std::vector<float> wall;    /**< Fraction of wall cells per pixel */
+    std::vector<std::vector<unsigned char>> freeFrames;
+    std::deque<std::vector<unsigned char>> pending;
+    std::mutex lock;
+    std::condition_variable changed;
+    bool stopping;
+    std::thread writer;
+
+    VideoWriter(const VideoWriter&);
+    VideoWriter& operator=(const VideoWriter&);
+};
+
+#endif // VIDEO_H
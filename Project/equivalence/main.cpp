@@ -0,0 +1,84 @@
+/**
+ * @file main.cpp
+ * @brief Compares the field checksums of backends against a reference run.
+ *
+ * Every backend writes the checksums of its field with --checksums. This tool
+ * reads the reference file and any number of candidates and reports for each
+ * candidate the first checksum at which it leaves the reference, with both
+ * values, so a broken optimization is pinpointed to a step instead of showing
+ * up as a different picture at the end. Without --tolerance the hashes must
+ * agree, i.e. the fields bit for bit. The exit status is 1 if any candidate
+ * diverges or cannot be read.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "checksum.h"
+
+/**
+ * @brief Prints one checksum of a run, or that the run has ended.
+ */
+static void printChecksum(const char* name, const std::vector<FieldChecksum>& run, long index) {
+    if (index >= static_cast<long>(run.size())) {
+        std::printf("  %-10s ended after %zu checksums\n", name, run.size());
+        return;
+    }
+    const FieldChecksum& c = run[index];
+    std::printf("  %-10s step %lld, hash %016llx, sum %.17g, energy %.17g\n", name, c.step,
+                static_cast<unsigned long long>(c.hash), c.sum, c.energy);
+}
+
+int main(int argc, char* argv[]) {
+    // Usage: equivalence.out [--tolerance <rel>] [--N <n>] reference candidate...
+    double tolerance = 0.0;
+    int n = 256;
+    std::vector<std::string> paths;
+    for (int a = 1; a < argc; ++a) {
+        bool hasValue = a + 1 < argc;
+        if (hasValue && std::strcmp(argv[a], "--tolerance") == 0) {
+            tolerance = std::atof(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--N") == 0) {
+            n = std::atoi(argv[++a]);
+        } else {
+            paths.push_back(argv[a]);
+        }
+    }
+    if (paths.size() < 2) {
+        std::fprintf(stderr, "Usage: %s [--tolerance <rel>] [--N <n>] reference candidate...\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<FieldChecksum> reference;
+    if (!readChecksums(paths[0], reference) || reference.empty()) {
+        std::fprintf(stderr, "Could not read checksums from %s\n", paths[0].c_str());
+        return 1;
+    }
+
+    bool equivalent = true;
+    for (size_t f = 1; f < paths.size(); ++f) {
+        std::vector<FieldChecksum> candidate;
+        if (!readChecksums(paths[f], candidate)) {
+            std::printf("%s: could not read checksums\n", paths[f].c_str());
+            equivalent = false;
+            continue;
+        }
+
+        long k = firstDivergence(reference, candidate, n, tolerance);
+        if (k < 0) {
+            std::printf("%s: matches %s at all %zu checksums (up to step %lld)\n", paths[f].c_str(), paths[0].c_str(),
+                        reference.size(), reference.back().step);
+            continue;
+        }
+
+        // The divergence lies between the last matching checksum and this one
+        long long after = k > 0 ? reference[k - 1].step : -1;
+        std::printf("%s: diverges from %s after step %lld\n", paths[f].c_str(), paths[0].c_str(), after);
+        printChecksum("reference", reference, k);
+        printChecksum("candidate", candidate, k);
+        equivalent = false;
+    }
+    return equivalent ? 0 : 1;
+}
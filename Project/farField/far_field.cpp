@@ -0,0 +1,112 @@
+/**
+ * @file far_field.cpp
+ * @brief Implementation of the Fraunhofer approximation declared in far_field.h.
+ */
+
+#include "far_field.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include "fft.h"
+
+std::vector<double> apertureFunction(const std::vector<std::vector<bool>>& mask, int row) {
+    std::vector<double> aperture(mask[row].size(), 0.0);
+    for (size_t j = 0; j < aperture.size(); ++j) {
+        aperture[j] = mask[row][j] ? 0.0 : 1.0;
+    }
+    return aperture;
+}
+
+/**
+ * @brief Scales a profile to a maximum of 1.
+ */
+static std::vector<double> normalised(const std::vector<double>& profile) {
+    double peak = profile.empty() ? 0.0 : *std::max_element(profile.begin(), profile.end());
+    std::vector<double> result(profile);
+    if (peak > 0.0) {
+        for (size_t j = 0; j < result.size(); ++j) {
+            result[j] /= peak;
+        }
+    }
+    return result;
+}
+
+std::vector<double> farFieldScreen(const SimulationConfig& config) {
+    const int n = config.N;
+    const double dx = config.boxsize / n;
+
+    // The geometry of the time-domain solver, so both see the same slits
+    std::vector<double> xlin(n);
+    std::vector<std::vector<double>> U(n, std::vector<double>(n, 0.0));
+    std::vector<std::vector<bool>> mask(n, std::vector<bool>(n, false));
+    initializeGrid(U, mask, xlin, config);
+
+    // The barrier occupies rows n/4 .. 9n/32 - 1; distances are measured from its exit
+    int barrierRow = n / 4;
+    double barrierY = (9 * n / 32) * dx;
+    double screenY = (std::floor(config.screen * n + 1e-9) + 0.5) * dx;
+    double distance = std::max(screenY - barrierY, dx);
+
+    std::vector<double> aperture = apertureFunction(mask, barrierRow);
+    double centre = 0.0, weight = 0.0;
+    for (int j = 0; j < n; ++j) {
+        aperture[j] *= std::pow(std::sin(M_PI * xlin[j]), 2);
+        centre += aperture[j] * xlin[j];
+        weight += aperture[j];
+    }
+    centre = weight > 0.0 ? centre / weight : 0.5 * config.boxsize;
+
+    // Zero padding samples the spectrum finely enough to interpolate it linearly
+    size_t m = nextPowerOfTwo(32 * static_cast<size_t>(n));
+    std::vector<std::complex<double>> spectrum(m, 0.0);
+    for (int j = 0; j < n; ++j) {
+        spectrum[j] = aperture[j] * dx;
+    }
+    fft(spectrum);
+
+    // Bin k holds spatial frequency k / (m dx), negative frequencies wrap around
+    double wavelength = config.c / config.frequency;
+    std::vector<double> intensity(n, 0.0);
+    for (int j = 0; j < n; ++j) {
+        double offset = xlin[j] - centre;
+        double r = std::sqrt(offset * offset + distance * distance);
+        double frequency = offset / r / wavelength;
+        double bin = frequency * m * dx;
+        double lower = std::floor(bin);
+        double fraction = bin - lower;
+        long k0 = static_cast<long>(lower) % static_cast<long>(m);
+        if (k0 < 0) {
+            k0 += static_cast<long>(m);
+        }
+        size_t k1 = (static_cast<size_t>(k0) + 1) % m;
+        double power = (1.0 - fraction) * std::norm(spectrum[k0]) + fraction * std::norm(spectrum[k1]);
+        intensity[j] = power / r;
+    }
+    return normalised(intensity);
+}
+
+ProfileComparison compareProfiles(const std::vector<double>& a, const std::vector<double>& b) {
+    std::vector<double> x = normalised(a);
+    std::vector<double> y = normalised(b);
+    const double n = static_cast<double>(x.size());
+
+    double meanX = 0.0, meanY = 0.0;
+    for (size_t j = 0; j < x.size(); ++j) {
+        meanX += x[j] / n;
+        meanY += y[j] / n;
+    }
+    double covariance = 0.0, varianceX = 0.0, varianceY = 0.0, squares = 0.0;
+    for (size_t j = 0; j < x.size(); ++j) {
+        covariance += (x[j] - meanX) * (y[j] - meanY);
+        varianceX += (x[j] - meanX) * (x[j] - meanX);
+        varianceY += (y[j] - meanY) * (y[j] - meanY);
+        squares += (x[j] - y[j]) * (x[j] - y[j]);
+    }
+
+    ProfileComparison comparison;
+    comparison.correlation = varianceX > 0.0 && varianceY > 0.0 ? covariance / std::sqrt(varianceX * varianceY) : 0.0;
+    comparison.rmsError = std::sqrt(squares / n);
+    comparison.peakShift = static_cast<int>(std::max_element(x.begin(), x.end()) - x.begin())
+                         - static_cast<int>(std::max_element(y.begin(), y.end()) - y.begin());
+    return comparison;
+}
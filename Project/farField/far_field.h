@@ -0,0 +1,49 @@
+/**
+ * @file far_field.h
+ * @brief Fraunhofer approximation of the screen intensity.
+ *
+ * Instead of stepping the wave equation, the aperture function is read from
+ * the mask row at the barrier, weighted with the inflow profile sin^2(pi x),
+ * and Fourier transformed. In the Fraunhofer limit the amplitude in direction
+ * theta is the transform at spatial frequency sin(theta) / lambda, and in two
+ * dimensions the intensity falls off as 1/r. The screen is only a few
+ * wavelengths behind the barrier, so this predicts the positions of the fringes
+ * well but their relative heights only approximately.
+ */
+#ifndef FAR_FIELD_H
+#define FAR_FIELD_H
+
+#include <vector>
+#include "simulation.h"
+
+/**
+ * @brief Returns the aperture function of a mask row: 1 where open, 0 at walls.
+ *
+ * @param mask Grid mask.
+ * @param row Row of the barrier.
+ */
+std::vector<double> apertureFunction(const std::vector<std::vector<bool>>& mask, int row);
+
+/**
+ * @brief Predicts the intensity along the screen row in the Fraunhofer limit.
+ *
+ * @param config Simulation parameters; tEnd is ignored.
+ * @return Intensity per screen column, normalised to a maximum of 1.
+ */
+std::vector<double> farFieldScreen(const SimulationConfig& config);
+
+/**
+ * @brief Agreement of two screen profiles after normalising both to a maximum of 1.
+ */
+struct ProfileComparison {
+    double correlation; /**< Pearson correlation */
+    double rmsError;    /**< Root mean square difference */
+    int peakShift;      /**< Offset between the maxima in columns */
+};
+
+/**
+ * @brief Compares two screen profiles of equal length.
+ */
+ProfileComparison compareProfiles(const std::vector<double>& a, const std::vector<double>& b);
+
+#endif // FAR_FIELD_H
@@ -0,0 +1,47 @@
+/**
+ * @file fft.cpp
+ * @brief Implementation of the FFT declared in fft.h.
+ */
+
+#include "fft.h"
+#include <cmath>
+#include <utility>
+
+size_t nextPowerOfTwo(size_t n) {
+    size_t power = 1;
+    while (power < n) {
+        power *= 2;
+    }
+    return power;
+}
+
+void fft(std::vector<std::complex<double>>& data) {
+    const size_t n = data.size();
+
+    // Bit-reversal permutation, so the butterflies below can work in place
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    for (size_t length = 2; length <= n; length *= 2) {
+        double angle = -2.0 * M_PI / length;
+        std::complex<double> step(std::cos(angle), std::sin(angle));
+        for (size_t start = 0; start < n; start += length) {
+            std::complex<double> twiddle(1.0, 0.0);
+            for (size_t k = 0; k < length / 2; ++k) {
+                std::complex<double> even = data[start + k];
+                std::complex<double> odd = data[start + k + length / 2] * twiddle;
+                data[start + k] = even + odd;
+                data[start + k + length / 2] = even - odd;
+                twiddle *= step;
+            }
+        }
+    }
+}
@@ -0,0 +1,25 @@
+/**
+ * @file fft.h
+ * @brief In-place radix-2 fast Fourier transform.
+ */
+#ifndef FFT_H
+#define FFT_H
+
+#include <complex>
+#include <vector>
+
+/**
+ * @brief Returns the smallest power of two that is at least n.
+ */
+size_t nextPowerOfTwo(size_t n);
+
+/**
+ * @brief Computes the discrete Fourier transform in place.
+ *
+ * X[k] = sum_j x[j] exp(-2 pi i j k / n), with n a power of two.
+ *
+ * @param data Values to transform; replaced by their transform.
+ */
+void fft(std::vector<std::complex<double>>& data);
+
+#endif // FFT_H
@@ -0,0 +1,79 @@
+/**
+ * @file main.cpp
+ * @brief Predicts the screen intensity of the double slit without a time-domain run.
+ *
+ * The Fraunhofer pattern of the aperture is computed with an FFT in a few
+ * milliseconds. With --compare the time-domain solver of unitTests/simulation.cpp
+ * is run as well and the two screen profiles are compared. The profiles are
+ * written as text with one line "x farField [timeDomain]" per screen column.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "far_field.h"
+#include "simulation.h"
+
+int main(int argc, char* argv[]) {
+    // Optional arguments: --N <n> --frequency <f> --slitWidth <w> --slitSpacing <s>
+    //                     --screen <y> --tEnd <t> --output <file> --compare
+    SimulationConfig config = defaultConfig();
+    std::string output = "far_field.txt";
+    bool compare = false;
+    for (int a = 1; a < argc; ++a) {
+        bool hasValue = a + 1 < argc;
+        if (std::strcmp(argv[a], "--compare") == 0) {
+            compare = true;
+        } else if (hasValue && std::strcmp(argv[a], "--N") == 0) {
+            config.N = std::atoi(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--frequency") == 0) {
+            config.frequency = std::atof(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--slitWidth") == 0) {
+            config.slitWidth = std::atof(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--slitSpacing") == 0) {
+            config.slitSpacing = std::atof(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--screen") == 0) {
+            config.screen = std::atof(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--tEnd") == 0) {
+            config.tEnd = std::atof(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--output") == 0) {
+            output = argv[++a];
+        }
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<double> predicted = farFieldScreen(config);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "Far field: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+    std::vector<double> simulated;
+    if (compare) {
+        start = std::chrono::high_resolution_clock::now();
+        simulated = runSimulation(config);
+        end = std::chrono::high_resolution_clock::now();
+        std::cout << "Time domain: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+        ProfileComparison comparison = compareProfiles(predicted, simulated);
+        std::cout << "Correlation: " << comparison.correlation << ", RMS error: " << comparison.rmsError
+                  << ", Peak shift: " << comparison.peakShift << " cells" << std::endl;
+    }
+
+    std::ofstream out(output.c_str());
+    if (!out) {
+        std::cerr << "Could not open " << output << " for writing" << std::endl;
+        return 1;
+    }
+    double dx = config.boxsize / config.N;
+    for (int j = 0; j < config.N; ++j) {
+        out << (j + 0.5) * dx << " " << predicted[j];
+        if (compare) {
+            out << " " << simulated[j];
+        }
+        out << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file half_float.cpp
+ * @brief Implementation of the conversions declared in half_float.h.
+ */
+
+#include "half_float.h"
+#include <cstring>
+#if defined(__F16C__) || defined(__AVX512BF16__)
+#include <immintrin.h>
+#endif
+
+static uint32_t floatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float bitsFloat(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+const char* formatName(StorageFormat format) {
+    return format == STORAGE_FP16 ? "fp16" : "bf16";
+}
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits = floatBits(value);
+    uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    uint32_t magnitude = bits & 0x7fffffff;
+
+    if (magnitude >= 0x7f800000) {
+        // Infinity stays infinity, NaNs stay quiet NaNs with the upper payload bits
+        return magnitude == 0x7f800000 ? (sign | 0x7c00) : (sign | 0x7e00 | ((magnitude >> 13) & 0x3ff));
+    }
+    if (magnitude >= 0x477ff000) {
+        // At or above 65520 rounding reaches infinity
+        return sign | 0x7c00;
+    }
+    if (magnitude >= 0x38800000) {
+        // Normal range: rebias the exponent and round the 13 dropped bits to nearest even
+        uint32_t rounded = magnitude - 0x38000000;
+        rounded += 0x0fff + ((rounded >> 13) & 1);
+        return sign | static_cast<uint16_t>(rounded >> 13);
+    }
+    if (magnitude < 0x33000000) {
+        // Below half the smallest subnormal everything rounds to zero
+        return sign;
+    }
+
+    // Subnormal result: shift the mantissa with its implicit bit into place
+    int exponent = static_cast<int>(magnitude >> 23);
+    uint32_t mantissa = (magnitude & 0x7fffff) | 0x800000;
+    int shift = 126 - exponent;
+    uint32_t result = mantissa >> shift;
+    uint32_t remainder = mantissa & ((1u << shift) - 1);
+    uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (result & 1))) {
+        ++result;
+    }
+    return sign | static_cast<uint16_t>(result);
+}
+
+float halfToFloat(uint16_t half) {
+    uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1f;
+    uint32_t mantissa = half & 0x3ff;
+
+    if (exponent == 0x1f) {
+        return bitsFloat(sign | 0x7f800000 | (mantissa << 13));
+    }
+    if (exponent != 0) {
+        return bitsFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+    }
+    if (mantissa == 0) {
+        return bitsFloat(sign);
+    }
+
+    // Subnormal: normalise the mantissa
+    exponent = 113;
+    while ((mantissa & 0x400) == 0) {
+        mantissa <<= 1;
+        --exponent;
+    }
+    return bitsFloat(sign | (exponent << 23) | ((mantissa & 0x3ff) << 13));
+}
+
+uint16_t floatToBfloat16(float value) {
+    uint32_t bits = floatBits(value);
+    if ((bits & 0x7fffffff) > 0x7f800000) {
+        return static_cast<uint16_t>((bits >> 16) | 0x40);
+    }
+    if ((bits & 0x7f800000) == 0) {
+        // Subnormals flush to zero, as in the AVX-512 instruction
+        return static_cast<uint16_t>((bits >> 16) & 0x8000);
+    }
+    bits += 0x7fff + ((bits >> 16) & 1);
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+float bfloat16ToFloat(uint16_t value) {
+    return bitsFloat(static_cast<uint32_t>(value) << 16);
+}
+
+bool hardwareConversion(StorageFormat format) {
+#if defined(__F16C__)
+    if (format == STORAGE_FP16) {
+        return true;
+    }
+#endif
+#if defined(__AVX512BF16__)
+    if (format == STORAGE_BF16) {
+        return true;
+    }
+#endif
+    return false;
+}
+
+void decodeRow(StorageFormat format, const uint16_t* in, float* out, int n) {
+    int j = 0;
+    if (format == STORAGE_FP16) {
+#if defined(__F16C__)
+        for (; j + 8 <= n; j += 8) {
+            __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + j));
+            _mm256_storeu_ps(out + j, _mm256_cvtph_ps(half));
+        }
+#endif
+        for (; j < n; ++j) {
+            out[j] = halfToFloat(in[j]);
+        }
+    } else {
+        // A shift into the upper half; the compiler vectorizes it
+        for (; j < n; ++j) {
+            out[j] = bfloat16ToFloat(in[j]);
+        }
+    }
+}
+
+void encodeRow(StorageFormat format, const float* in, uint16_t* out, int n) {
+    int j = 0;
+    if (format == STORAGE_FP16) {
+#if defined(__F16C__)
+        for (; j + 8 <= n; j += 8) {
+            __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(in + j), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + j), half);
+        }
+#endif
+        for (; j < n; ++j) {
+            out[j] = floatToHalf(in[j]);
+        }
+    } else {
+#if defined(__AVX512BF16__)
+        for (; j + 16 <= n; j += 16) {
+            __m256bh packed = _mm512_cvtneps_pbh(_mm512_loadu_ps(in + j));
+            std::memcpy(out + j, &packed, sizeof(packed));
+        }
+#endif
+        for (; j < n; ++j) {
+            out[j] = floatToBfloat16(in[j]);
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * @file half_float.h
+ * @brief Conversions between float and the 16-bit storage formats.
+ *
+ * Two formats are supported: IEEE binary16 (fp16: 5 exponent bits, 10
+ * mantissa bits, range up to 65504) and bfloat16 (bf16: the upper half of a
+ * float, 8 exponent bits and 7 mantissa bits). Both round to nearest, ties to
+ * even.
+ *
+ * The row conversions use the F16C instructions for fp16 when compiled with
+ * -mf16c, and the AVX-512 BF16 instruction for bf16 when compiled with
+ * -mavx512bf16; otherwise they fall back to the portable scalar conversions
+ * below, which give the same bits. Like the instruction, the bf16 conversion
+ * flushes subnormal floats to zero.
+ */
+#ifndef HALF_FLOAT_H
+#define HALF_FLOAT_H
+
+#include <cstdint>
+
+/**
+ * @brief 16-bit storage format of a field.
+ */
+enum StorageFormat {
+    STORAGE_FP16,
+    STORAGE_BF16
+};
+
+/**
+ * @brief Returns the name of a format, "fp16" or "bf16".
+ */
+const char* formatName(StorageFormat format);
+
+/**
+ * @brief Converts a float to fp16 without special instructions.
+ */
+uint16_t floatToHalf(float value);
+
+/**
+ * @brief Converts an fp16 value to float without special instructions; exact.
+ */
+float halfToFloat(uint16_t half);
+
+/**
+ * @brief Converts a float to bf16 without special instructions.
+ */
+uint16_t floatToBfloat16(float value);
+
+/**
+ * @brief Converts a bf16 value to float; exact.
+ */
+float bfloat16ToFloat(uint16_t value);
+
+/**
+ * @brief Returns whether the row conversions of a format use conversion instructions.
+ */
+bool hardwareConversion(StorageFormat format);
+
+/**
+ * @brief Converts a row of 16-bit values to float.
+ *
+ * @param format Format of the input.
+ * @param in n stored values.
+ * @param out Receives n floats.
+ * @param n Number of values.
+ */
+void decodeRow(StorageFormat format, const uint16_t* in, float* out, int n);
+
+/**
+ * @brief Converts a row of floats to 16-bit values.
+ *
+ * @param format Format of the output.
+ * @param in n floats.
+ * @param out Receives n stored values.
+ * @param n Number of values.
+ */
+void encodeRow(StorageFormat format, const float* in, uint16_t* out, int n);
+
+#endif // HALF_FLOAT_H
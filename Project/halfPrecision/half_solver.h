@@ -0,0 +1,88 @@
+/**
+ * @file half_solver.h
+ * @brief Leapfrog wave solver storing its fields in 16 bits and computing in float.
+ *
+ * The stencil moves far fewer operations per byte than the hardware can
+ * sustain, so on large grids the time per step is set by memory traffic. This
+ * solver stores U, Uprev and Unew as fp16 or bf16 values, a quarter of the
+ * bytes of doubles, and converts each row to float only while it is being
+ * used: three decoded rows of U and one of Uprev live in a small scratch
+ * buffer that stays in cache, and the new row is rounded back on the way out.
+ *
+ * The geometry, source and boundary conditions are those of the reference in
+ * unitTests/simulation.h, so a HalfSimulation and an unmirrored Simulation of
+ * the same configuration can be compared step by step.
+ */
+#ifndef HALF_SOLVER_H
+#define HALF_SOLVER_H
+
+#include <cstdint>
+#include <vector>
+#include "half_float.h"
+#include "simulation.h"
+
+/**
+ * @brief State of a simulation with 16-bit fields.
+ *
+ * The fields are n x n and stored row by row in one block each.
+ */
+struct HalfSimulation {
+    SimulationConfig config;
+    StorageFormat format;
+    std::vector<double> xlin;
+    std::vector<uint16_t> U;            /**< Field at the current time */
+    std::vector<uint16_t> Uprev;        /**< Field one step earlier */
+    std::vector<uint16_t> Unew;         /**< Scratch for the next field */
+    std::vector<unsigned char> active;  /**< 1 for cells that are updated, 0 for walls and barrier */
+    std::vector<float> scratch;         /**< Decoded rows of the current step */
+    std::vector<double> screen;         /**< Time-integrated intensity U^2 along the screen row */
+    double dt;
+    double fac;
+    double t;
+};
+
+/**
+ * @brief Difference between a 16-bit field and the double-precision reference.
+ */
+struct FieldError {
+    double relativeL2; /**< ||U - Uref|| / ||Uref||, or the absolute norm if Uref is zero */
+    double maxAbs;     /**< Largest |U - Uref| of a cell */
+};
+
+/**
+ * @brief Allocates and initializes a simulation.
+ *
+ * @param sim Simulation to initialize.
+ * @param config Simulation parameters.
+ * @param format Storage format of the fields.
+ */
+void initializeHalfSimulation(HalfSimulation& sim, const SimulationConfig& config, StorageFormat format);
+
+/**
+ * @brief Advances a simulation by one time step and accumulates the screen intensity.
+ *
+ * @param sim Simulation to advance.
+ */
+void stepHalfSimulation(HalfSimulation& sim);
+
+/**
+ * @brief Returns the current field converted to double.
+ *
+ * @param sim Simulation to read.
+ */
+std::vector<std::vector<double>> decodedField(const HalfSimulation& sim);
+
+/**
+ * @brief Compares the current field with that of a reference simulation.
+ *
+ * @param sim 16-bit simulation.
+ * @param reference Unmirrored simulation of the same configuration at the same step.
+ */
+FieldError fieldError(const HalfSimulation& sim, const Simulation& reference);
+
+/**
+ * @brief Returns the relative L2 difference of two screen intensities.
+ */
+double screenError(const std::vector<double>& screen, const std::vector<double>& reference);
+
+#endif // HALF_SOLVER_H
@@ -0,0 +1,100 @@
+/**
+ * @file main.cpp
+ * @brief Runs the double slit with 16-bit fields and tracks the error against doubles.
+ *
+ * Each storage format is stepped in lockstep with the double-precision
+ * reference of unitTests/simulation.h. Every few steps the relative L2 and
+ * the largest cell error of the field are printed, and at the end the time
+ * per step of both solvers and the error of the screen intensity, which is
+ * the result the visualisation and the far-field analysis use.
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "half_float.h"
+#include "half_solver.h"
+#include "simulation.h"
+
+int main(int argc, char* argv[]) {
+    // Optional arguments: --format fp16|bf16 --N <n> --tEnd <t> --error-every <steps>
+    SimulationConfig config = defaultConfig();
+    std::vector<StorageFormat> formats;
+    int errorEvery = 50;
+    for (int a = 1; a < argc; ++a) {
+        bool hasValue = a + 1 < argc;
+        if (hasValue && std::strcmp(argv[a], "--format") == 0) {
+            ++a;
+            if (std::strcmp(argv[a], "fp16") == 0) {
+                formats.assign(1, STORAGE_FP16);
+            } else if (std::strcmp(argv[a], "bf16") == 0) {
+                formats.assign(1, STORAGE_BF16);
+            } else {
+                std::cerr << "Unknown format " << argv[a] << ", expected fp16 or bf16" << std::endl;
+                return 1;
+            }
+        } else if (hasValue && std::strcmp(argv[a], "--N") == 0) {
+            config.N = std::atoi(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--tEnd") == 0) {
+            config.tEnd = std::atof(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--error-every") == 0) {
+            errorEvery = std::max(1, std::atoi(argv[++a]));
+        }
+    }
+    if (formats.empty()) {
+        formats.push_back(STORAGE_FP16);
+        formats.push_back(STORAGE_BF16);
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    for (size_t k = 0; k < formats.size(); ++k) {
+        StorageFormat format = formats[k];
+        Simulation reference;
+        initializeSimulation(reference, config, false);
+        HalfSimulation sim;
+        initializeHalfSimulation(sim, config, format);
+
+        std::cout << formatName(format) << " storage, "
+                  << (hardwareConversion(format) ? "conversion instructions" : "portable conversion") << std::endl;
+        std::printf("%8s %10s %14s %14s\n", "step", "t", "relative L2", "max error");
+
+        // Both solvers advance together; each is timed on its own
+        double halfSeconds = 0.0;
+        double doubleSeconds = 0.0;
+        long steps = 0;
+        FieldError error = { 0.0, 0.0 };
+        while (reference.t < config.tEnd) {
+            Clock::time_point start = Clock::now();
+            stepHalfSimulation(sim);
+            Clock::time_point middle = Clock::now();
+            stepSimulation(reference);
+            Clock::time_point end = Clock::now();
+            halfSeconds += std::chrono::duration<double>(middle - start).count();
+            doubleSeconds += std::chrono::duration<double>(end - middle).count();
+            ++steps;
+
+            bool last = !(reference.t < config.tEnd);
+            if (steps % errorEvery == 0 || last) {
+                error = fieldError(sim, reference);
+                std::printf("%8ld %10.4f %14.3e %14.3e\n", steps, reference.t, error.relativeL2, error.maxAbs);
+            }
+        }
+
+        // Bytes of U, Uprev, Unew and the mask
+        double halfBytes = 3 * sizeof(uint16_t) + sizeof(unsigned char);
+        double doubleBytes = 3 * sizeof(double) + 1.0 / 8;
+        std::printf("Time per step: %.3f ms (%s, %.1f bytes/cell) vs %.3f ms (double, %.1f bytes/cell), speedup %.2f\n",
+                    1e3 * halfSeconds / steps, formatName(format), halfBytes, 1e3 * doubleSeconds / steps, doubleBytes,
+                    doubleSeconds / halfSeconds);
+        std::printf("Final field error: relative L2 %.3e, max %.3e; screen intensity error: %.3e\n",
+                    error.relativeL2, error.maxAbs, screenError(sim.screen, reference.screen));
+        if (k + 1 < formats.size()) {
+            std::cout << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file high_order.h
+ * @brief Wave solver with a fourth-order-in-time modified-equation leapfrog.
+ *
+ * Leapfrog is second order in time and only stable up to the Courant number
+ * c dt / dx = 1/sqrt(2), so the number of steps grows linearly with N. The
+ * modified-equation scheme cancels the leading time error of leapfrog with the
+ * Laplacian of the Laplacian:
+ *
+ *     Unew = 2 U - Uprev + fac L + fac^2 / 12 lap(L),   L = lap(U),
+ *
+ * which is fourth order in time and stable up to c dt / dx = sqrt(3/2), so it
+ * takes sqrt(3) times fewer steps. L is computed one row ahead into a window
+ * of three rows that stays in cache, so a step still streams U, Uprev and
+ * Unew once, like a leapfrog step.
+ *
+ * Walls hold U = 0 at all times, so L is zero there. On the inflow row
+ * U = sin(2 pi f t) sin^2(pi x), so L = -(2 pi f dx / c)^2 U. The geometry is
+ * that of unitTests/simulation.h. Unlike the reference, the inflow is set at
+ * the time of the field it belongs to; a source that lags by one step would
+ * add a first-order error that grows with dt.
+ */
+#ifndef HIGH_ORDER_H
+#define HIGH_ORDER_H
+
+#include <vector>
+#include "simulation.h"
+
+/**
+ * @brief Time integrator.
+ */
+enum TimeScheme {
+    SCHEME_LEAPFROG,         /**< Second-order leapfrog, as the reference */
+    SCHEME_MODIFIED_EQUATION /**< Fourth-order modified-equation leapfrog */
+};
+
+/**
+ * @brief Returns the name of a scheme as used on the command line.
+ */
+const char* schemeName(TimeScheme scheme);
+
+/**
+ * @brief Returns the largest stable Courant number c dt / dx of a scheme on the 2D grid.
+ */
+double courantLimit(TimeScheme scheme);
+
+/**
+ * @brief Returns the Courant number at which a scheme has the phase error of
+ *        leapfrog at its stability limit, at the source frequency.
+ *
+ * Per step the relative phase error of a wave of angular frequency w is
+ * (w dt)^2 / 24 for leapfrog and (w dt)^4 / 720 for the modified equation.
+ *
+ * @param config Simulation parameters.
+ * @param scheme Time integrator.
+ */
+double accuracyCourant(const SimulationConfig& config, TimeScheme scheme);
+
+/**
+ * @brief Time step of a run.
+ */
+struct TimeStep {
+    double courant; /**< c dt / dx */
+    double dt;
+    long steps;     /**< Steps to config.tEnd */
+};
+
+/**
+ * @brief Chooses the time step of a run.
+ *
+ * The automatic Courant number is the smaller of the stability limit and the
+ * accuracy of leapfrog. dt is then shortened so that a whole number of steps
+ * ends exactly at config.tEnd, which lets runs with different time steps be
+ * compared.
+ *
+ * @param config Simulation parameters.
+ * @param scheme Time integrator.
+ * @param courant Requested Courant number, 0 for automatic.
+ */
+TimeStep chooseTimeStep(const SimulationConfig& config, TimeScheme scheme, double courant = 0.0);
+
+/**
+ * @brief State of a running simulation.
+ *
+ * The fields are n x n and stored row by row in one block each.
+ */
+struct HighOrderSimulation {
+    SimulationConfig config;
+    TimeScheme scheme;
+    std::vector<double> xlin;
+    std::vector<double> U;             /**< Field at the current time */
+    std::vector<double> Uprev;         /**< Field one step earlier */
+    std::vector<double> Unew;          /**< Scratch for the next field */
+    std::vector<unsigned char> active; /**< 1 for cells that are updated, 0 for walls and barrier */
+    std::vector<double> laplacian;     /**< Three rows of L, indexed by row modulo 3 */
+    double dt;
+    double fac;                        /**< (c dt / dx)^2 */
+    double sourceFac;                  /**< L / U on the inflow row */
+    double t;
+    long step;
+};
+
+/**
+ * @brief Allocates and initializes a simulation.
+ *
+ * @param sim Simulation to initialize.
+ * @param config Simulation parameters.
+ * @param scheme Time integrator.
+ * @param timeStep Time step, see chooseTimeStep().
+ */
+void initializeHighOrder(HighOrderSimulation& sim, const SimulationConfig& config, TimeScheme scheme,
+                         const TimeStep& timeStep);
+
+/**
+ * @brief Advances a simulation by one time step.
+ *
+ * @param sim Simulation to advance.
+ */
+void stepHighOrder(HighOrderSimulation& sim);
+
+/**
+ * @brief Advances a simulation by a number of steps.
+ *
+ * @param sim Simulation to advance.
+ * @param steps Number of steps.
+ */
+void runHighOrder(HighOrderSimulation& sim, long steps);
+
+/**
+ * @brief Returns ||a - b|| / ||b|| of two fields of the same size.
+ */
+double relativeDifference(const std::vector<double>& a, const std::vector<double>& b);
+
+/**
+ * @brief Returns the sum of U^2 over the grid.
+ */
+double highOrderEnergy(const HighOrderSimulation& sim);
+
+#endif // HIGH_ORDER_H
@@ -0,0 +1,95 @@
+/**
+ * @file main.cpp
+ * @brief Runs the double slit with the fourth-order modified-equation scheme and reports the steps saved.
+ *
+ * The time step is chosen automatically unless --courant is given. The steps
+ * are compared with those of leapfrog at its stability limit, which is what
+ * every other backend takes. With --compare both schemes run, and their final
+ * fields are compared with a reference taken with an eight times smaller
+ * step, so the time error of each scheme and the wall time it took can be
+ * weighed against each other.
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "high_order.h"
+#include "simulation.h"
+
+/**
+ * @brief Runs a scheme to config.tEnd and returns the wall time in seconds.
+ */
+static double timedRun(HighOrderSimulation& sim, const SimulationConfig& config, TimeScheme scheme,
+                       const TimeStep& timeStep) {
+    typedef std::chrono::steady_clock Clock;
+    initializeHighOrder(sim, config, scheme, timeStep);
+    Clock::time_point start = Clock::now();
+    runHighOrder(sim, timeStep.steps);
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    // Optional arguments: --scheme leapfrog|modified --courant <c> --N <n> --tEnd <t> --compare
+    SimulationConfig config = defaultConfig();
+    TimeScheme scheme = SCHEME_MODIFIED_EQUATION;
+    double courant = 0.0;
+    bool compare = false;
+    for (int a = 1; a < argc; ++a) {
+        bool hasValue = a + 1 < argc;
+        if (hasValue && std::strcmp(argv[a], "--scheme") == 0) {
+            ++a;
+            if (std::strcmp(argv[a], "leapfrog") == 0) {
+                scheme = SCHEME_LEAPFROG;
+            } else if (std::strcmp(argv[a], "modified") == 0) {
+                scheme = SCHEME_MODIFIED_EQUATION;
+            } else {
+                std::cerr << "Unknown scheme " << argv[a] << ", expected leapfrog or modified" << std::endl;
+                return 1;
+            }
+        } else if (hasValue && std::strcmp(argv[a], "--courant") == 0) {
+            courant = std::atof(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--N") == 0) {
+            config.N = std::atoi(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--tEnd") == 0) {
+            config.tEnd = std::atof(argv[++a]);
+        } else if (std::strcmp(argv[a], "--compare") == 0) {
+            compare = true;
+        }
+    }
+    if (courant > courantLimit(scheme)) {
+        std::cerr << "Courant number " << courant << " exceeds the stability limit " << courantLimit(scheme)
+                  << " of " << schemeName(scheme) << ", the run will blow up" << std::endl;
+    }
+
+    TimeStep timeStep = chooseTimeStep(config, scheme, courant);
+    TimeStep leapfrog = chooseTimeStep(config, SCHEME_LEAPFROG);
+    std::printf("Scheme: %s, Courant number %.4f (%s, stability limit %.4f), dt %.4e, %ld steps\n",
+                schemeName(scheme), timeStep.courant, courant > 0.0 ? "given" : "automatic", courantLimit(scheme),
+                timeStep.dt, timeStep.steps);
+    std::printf("Leapfrog at Courant number %.4f takes %ld steps: %ld steps (%.1f%%) saved\n", leapfrog.courant,
+                leapfrog.steps, leapfrog.steps - timeStep.steps,
+                100.0 * (leapfrog.steps - timeStep.steps) / leapfrog.steps);
+
+    HighOrderSimulation sim;
+    double seconds = timedRun(sim, config, scheme, timeStep);
+    std::printf("Execution time: %.6f seconds, Time per step: %.2f us, Field energy: %.6f\n", seconds,
+                1e6 * seconds / timeStep.steps, highOrderEnergy(sim));
+    if (!compare) {
+        return 0;
+    }
+
+    // Both schemes against a run whose time error is negligible next to theirs
+    TimeStep fine = chooseTimeStep(config, SCHEME_MODIFIED_EQUATION, std::min(timeStep.courant, leapfrog.courant) / 8);
+    HighOrderSimulation reference;
+    timedRun(reference, config, SCHEME_MODIFIED_EQUATION, fine);
+    HighOrderSimulation baseline;
+    double baselineSeconds = timedRun(baseline, config, SCHEME_LEAPFROG, leapfrog);
+    std::printf("Time error against %ld modified steps: %s %.3e, leapfrog %.3e\n", fine.steps, schemeName(scheme),
+                relativeDifference(sim.U, reference.U), relativeDifference(baseline.U, reference.U));
+    std::printf("Execution time: %s %.6f s, leapfrog %.6f s, speedup %.2f\n", schemeName(scheme), seconds,
+                baselineSeconds, baselineSeconds / seconds);
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file main.cpp
+ * @brief Prints the live metrics of running solvers.
+ *
+ * Reads one or more metrics files written with --metrics (for MPI runs all
+ * path.rank files) and prints one line per file. For several ranks the total
+ * energy, the slowest step rate and the imbalance of the compute time over
+ * the ranks (max/avg) follow. With --follow the files are read again every
+ * given number of seconds until all runs have finished.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "metrics.h"
+
+/**
+ * @brief Prints one table of all files.
+ *
+ * @return true if every file was read and its run has finished.
+ */
+static bool printMetrics(const std::vector<std::string>& paths) {
+    std::printf("%-6s %10s %12s %7s %12s %14s %10s %10s %9s %8s %s\n", "rank", "step", "time", "done", "steps/s",
+                "energy", "compute s", "wait s", "threads", "age s", "state");
+
+    double now = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    double energy = 0.0, computeSum = 0.0, computeMax = 0.0, slowest = 0.0;
+    int read = 0;
+    bool finished = true;
+    for (size_t f = 0; f < paths.size(); ++f) {
+        MetricsSnapshot s;
+        if (!readMetrics(paths[f], s)) {
+            std::printf("%-6s %s: no metrics\n", "-", paths[f].c_str());
+            finished = false;
+            continue;
+        }
+        const MetricsSample& m = s.sample;
+        std::printf("%-6d %10lld %12.6g %6.1f%% %12.1f %14.6g %10.3f %10.3f %9.3f %8.1f %s\n", s.rank, m.step, m.time,
+                    s.endTime > 0.0 ? std::min(100.0, 100.0 * m.time / s.endTime) : 0.0, m.stepRate, m.energy, m.computeSeconds,
+                    m.waitSeconds, m.imbalance, now - s.updated, s.finished ? "finished" : "running");
+
+        energy += m.energy;
+        computeSum += m.computeSeconds;
+        computeMax = std::max(computeMax, m.computeSeconds);
+        slowest = read == 0 ? m.stepRate : std::min(slowest, m.stepRate);
+        finished = finished && s.finished;
+        ++read;
+    }
+
+    if (read > 1) {
+        double imbalance = computeSum > 0.0 ? computeMax * read / computeSum : 1.0;
+        std::printf("%d ranks: energy %.6g, slowest %.1f steps/s, compute imbalance %.3f\n", read, energy, slowest,
+                    imbalance);
+    }
+    return finished;
+}
+
+int main(int argc, char* argv[]) {
+    // Usage: metrics.out [--follow <seconds>] <file>...
+    double follow = 0.0;
+    std::vector<std::string> paths;
+    for (int a = 1; a < argc; ++a) {
+        if (std::strcmp(argv[a], "--follow") == 0 && a + 1 < argc) {
+            follow = std::atof(argv[++a]);
+        } else {
+            paths.push_back(argv[a]);
+        }
+    }
+    if (paths.empty()) {
+        std::fprintf(stderr, "Usage: %s [--follow <seconds>] <metrics file>...\n", argv[0]);
+        return 1;
+    }
+
+    while (!printMetrics(paths) && follow > 0.0) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(follow));
+        std::printf("\n");
+    }
+    return 0;
+}
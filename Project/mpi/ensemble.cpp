@@ -0,0 +1,95 @@
+/**
+ * @file ensemble.cpp
+ * @brief Implementation of the ensemble mode declared in ensemble.h.
+ */
+
+#include "ensemble.h"
+#include "parameter_grid.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+/**
+ * @brief Sets one parameter of a problem by name.
+ *
+ * @return false if the name is unknown.
+ */
+static bool setParameter(Problem& problem, const std::string& name, double value) {
+    if (name == "N") {
+        problem.N = static_cast<int>(value);
+    } else if (name == "boxsize") {
+        problem.boxsize = value;
+    } else if (name == "c") {
+        problem.c = value;
+    } else if (name == "tEnd") {
+        problem.tEnd = value;
+    } else if (name == "frequency") {
+        problem.frequency = value;
+    } else if (name == "slitWidth") {
+        problem.slitWidth = value;
+    } else if (name == "slitSpacing") {
+        problem.slitSpacing = value;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool readEnsemble(const std::string& path, const Problem& defaults, std::vector<Problem>& members) {
+    return readParameterGrid(path, defaults, setParameter, members);
+}
+
+int ensembleGroup(int rank, int size, int groups) {
+    // Group g holds the ranks [g * size / groups, (g + 1) * size / groups)
+    int group = 0;
+    while (group + 1 < groups && (group + 1) * static_cast<long long>(size) / groups <= rank) {
+        ++group;
+    }
+    return group;
+}
+
+void reportEnsemble(MPI_Comm world, const std::vector<Problem>& members, const std::vector<RunSummary>& summaries,
+                    const char* csvPath) {
+    // Every member is summarised by exactly one rank, so a sum collects them all
+    const int fields = 6;
+    std::vector<double> local(members.size() * fields, 0.0);
+    for (size_t m = 0; m < members.size(); ++m) {
+        const RunSummary& s = summaries[m];
+        double values[fields] = { static_cast<double>(s.ranks), static_cast<double>(s.steps), s.seconds, s.energy,
+                                  s.maxAmplitude, s.imbalance };
+        std::copy(values, values + fields, local.begin() + m * fields);
+    }
+
+    int rank;
+    MPI_Comm_rank(world, &rank);
+    std::vector<double> all(local.size(), 0.0);
+    MPI_Reduce(local.data(), all.data(), static_cast<int>(local.size()), MPI_DOUBLE, MPI_SUM, 0, world);
+    if (rank != 0) {
+        return;
+    }
+
+    FILE* csv = csvPath != nullptr ? std::fopen(csvPath, "w") : nullptr;
+    if (csvPath != nullptr && csv == nullptr) {
+        std::cerr << "Could not open " << csvPath << " for writing" << std::endl;
+    }
+    if (csv != nullptr) {
+        std::fprintf(csv, "member,N,boxsize,c,tEnd,frequency,ranks,steps,seconds,energy,max_amplitude,imbalance\n");
+    }
+
+    std::printf("%-6s %6s %8s %8s %10s %6s %8s %10s %14s %12s %9s\n", "member", "N", "c", "tEnd", "frequency",
+                "ranks", "steps", "seconds", "energy", "max |U|", "imbalance");
+    for (size_t m = 0; m < members.size(); ++m) {
+        const Problem& p = members[m];
+        const double* v = &all[m * fields];
+        std::printf("%-6zu %6d %8g %8g %10g %6d %8lld %10.4f %14.6g %12.6g %9.3f\n", m, p.N, p.c, p.tEnd,
+                    p.frequency, static_cast<int>(v[0]), static_cast<long long>(v[1]), v[2], v[3], v[4], v[5]);
+        if (csv != nullptr) {
+            std::fprintf(csv, "%zu,%d,%.17g,%.17g,%.17g,%.17g,%d,%lld,%.9g,%.17g,%.17g,%.6g\n", m, p.N, p.boxsize,
+                         p.c, p.tEnd, p.frequency, static_cast<int>(v[0]), static_cast<long long>(v[1]), v[2], v[3],
+                         v[4], v[5]);
+        }
+    }
+    if (csv != nullptr) {
+        std::fclose(csv);
+    }
+}
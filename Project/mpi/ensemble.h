@@ -0,0 +1,75 @@
+/**
+ * @file ensemble.h
+ * @brief Ensembles of independent runs of the MPI solver in one job.
+ *
+ * An ensemble specification lists parameters with their values in the format
+ * of the sweep grid files (see common/parameter_grid.h); every combination is
+ * one member. MPI_COMM_WORLD is split into groups of contiguous ranks, each
+ * with its own Cartesian communicator and decomposition, and every group runs
+ * its share of the members one after another. The summaries of all members are
+ * combined on rank 0 at the end.
+ */
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include <string>
+#include <vector>
+#include <mpi.h>
+
+/**
+ * @brief Physical and numerical parameters of one run.
+ */
+struct Problem {
+    int N;              /**< Grid size */
+    double boxsize;     /**< Size of the computational domain */
+    double c;           /**< Speed of propagation */
+    double tEnd;        /**< End time of simulation */
+    double frequency;   /**< Frequency of the inflow source */
+    double slitWidth;   /**< Width of each slit, as a fraction of the box */
+    double slitSpacing; /**< Distance between the slit centres, as a fraction of the box */
+};
+
+/**
+ * @brief Summary of one run, valid on rank 0 of its group.
+ */
+struct RunSummary {
+    int ranks;           /**< Ranks of the group that ran it */
+    long long steps;     /**< Time steps taken */
+    double seconds;      /**< Wall time of the slowest rank */
+    double energy;       /**< Sum of U^2 over the grid at the end */
+    double maxAmplitude; /**< Largest |U| at the end */
+    double imbalance;    /**< Max over mean compute time of the ranks */
+};
+
+/**
+ * @brief Reads an ensemble specification.
+ *
+ * The file is a parameter grid of common/parameter_grid.h over N, boxsize, c,
+ * tEnd, frequency, slitWidth and slitSpacing.
+ *
+ * @param path Specification file.
+ * @param defaults Parameters of the default problem.
+ * @param members Receives one problem per combination of values.
+ * @return false if the file cannot be read, or a line names an unknown
+ *         parameter or has no or invalid values; the line is reported.
+ */
+bool readEnsemble(const std::string& path, const Problem& defaults, std::vector<Problem>& members);
+
+/**
+ * @brief Returns the group of a rank when size ranks form groups contiguous groups.
+ */
+int ensembleGroup(int rank, int size, int groups);
+
+/**
+ * @brief Combines the summaries of all members on rank 0 and prints them.
+ *
+ * @param world Communicator of all ranks.
+ * @param members Problems of all members.
+ * @param summaries Summaries indexed by member; only filled for the members
+ *                  this rank ran as rank 0 of its group, zero otherwise.
+ * @param csvPath Path of a CSV file with one line per member, or nullptr.
+ */
+void reportEnsemble(MPI_Comm world, const std::vector<Problem>& members, const std::vector<RunSummary>& summaries,
+                    const char* csvPath);
+
+#endif // ENSEMBLE_H
@@ -0,0 +1,177 @@
+/**
+ * @file frames.cpp
+ * @brief Implementation of the frame gathering declared in frames.h.
+ */
+
+#include "frames.h"
+#include <algorithm>
+#include <cmath>
+
+int framePixelRows(int startRow, int rows, int scale, int size, int& first) {
+    int last = std::min(startRow + rows, size * scale) - 1;
+    first = startRow / scale;
+    if (last < startRow) {
+        return 0;
+    }
+    return last / scale - first + 1;
+}
+
+long frameCount(const Problem& problem, int every) {
+    // The same accumulation of t as the time loop
+    double dt = (std::sqrt(2)/2) * (problem.boxsize / problem.N) / problem.c;
+    double t = 0.0;
+    long steps = 0;
+    while (t < problem.tEnd) {
+        t += dt;
+        ++steps;
+    }
+    return (steps + every - 1) / every;
+}
+
+std::vector<float> wallFractions(const Geometry& geometry, int n, int scale) {
+    scale = std::max(1, scale);
+    const int size = n / scale;
+    std::vector<float> walls(static_cast<size_t>(size) * size, 0.0f);
+
+    // One pixel row of the mask at a time
+    std::vector<bool> mask(static_cast<size_t>(scale) * n);
+    for (int p = 0; p < size; ++p) {
+        rasterizeRows(geometry, n, p * scale, scale, mask);
+        float* row = &walls[static_cast<size_t>(p) * size];
+        for (int i = 0; i < scale; ++i) {
+            for (int j = 0; j < size * scale; ++j) {
+                row[j / scale] += mask[static_cast<size_t>(i) * n + j] ? 1.0f : 0.0f;
+            }
+        }
+    }
+    for (size_t p = 0; p < walls.size(); ++p) {
+        walls[p] /= scale * scale;
+    }
+    return walls;
+}
+
+FrameSender::FrameSender()
+    : comm(MPI_COMM_NULL), root(0), grid(), scale(1), size(0), firstPixelRow(0), pixelRows(0),
+      request(MPI_REQUEST_NULL), waited(0.0) {}
+
+FrameSender::~FrameSender() {
+    finish();
+}
+
+void FrameSender::open(MPI_Comm frames, int root, const LocalGrid& grid, int scale) {
+    this->comm = frames;
+    this->root = root;
+    this->grid = grid;
+    this->scale = std::max(1, scale);
+    size = grid.cols / this->scale;
+    pixelRows = framePixelRows(grid.start_row, grid.local_N, this->scale, size, firstPixelRow);
+    buffer.assign(static_cast<size_t>(pixelRows) * size, 0.0f);
+    request = MPI_REQUEST_NULL;
+    waited = 0.0;
+}
+
+bool FrameSender::isOpen() const {
+    return comm != MPI_COMM_NULL;
+}
+
+void FrameSender::send(const std::vector<double>& U) {
+    // The buffer is reused, so the previous frame has to be out first
+    double start = MPI_Wtime();
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+    waited += MPI_Wtime() - start;
+
+    const int n = grid.cols;
+    std::fill(buffer.begin(), buffer.end(), 0.0f);
+    for (int i = 0; i < grid.local_N; ++i) {
+        int global_row = grid.start_row + i;
+        if (global_row >= size * scale) {
+            break;
+        }
+        float* pixels = &buffer[static_cast<size_t>(global_row / scale - firstPixelRow) * size];
+        const double* row = &U[static_cast<size_t>(grid.haloWidth + i) * n];
+        for (int j = 0; j < size * scale; ++j) {
+            pixels[j / scale] += static_cast<float>(row[j]);
+        }
+    }
+
+    // Only the root's receive arguments are used
+    MPI_Igatherv(buffer.data(), static_cast<int>(buffer.size()), MPI_FLOAT, nullptr, nullptr, nullptr, MPI_FLOAT,
+                 root, comm, &request);
+}
+
+void FrameSender::finish() {
+    if (request != MPI_REQUEST_NULL) {
+        double start = MPI_Wtime();
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+        waited += MPI_Wtime() - start;
+    }
+}
+
+double FrameSender::waitSeconds() const {
+    return waited;
+}
+
+FrameReport receiveFrames(MPI_Comm frames, const std::vector<LocalGrid>& blocks, int scale, long count,
+                          const std::vector<float>& walls, VideoWriter& video) {
+    scale = std::max(1, scale);
+    const int ranks = static_cast<int>(blocks.size()) + 1;
+    const int root = ranks - 1;
+    const int size = blocks.empty() ? 0 : blocks[0].cols / scale;
+
+    // Pixel rows of every compute rank; the output rank sends nothing
+    std::vector<int> counts(ranks, 0);
+    std::vector<int> displs(ranks, 0);
+    std::vector<int> firstRows(ranks, 0);
+    int total = 0;
+    for (int r = 0; r < root; ++r) {
+        int rows = framePixelRows(blocks[r].start_row, blocks[r].local_N, scale, size, firstRows[r]);
+        counts[r] = rows * size;
+        displs[r] = total;
+        total += counts[r];
+    }
+
+    // The next gather is posted before a frame is assembled, so the compute
+    // ranks can hand it over while the output rank is busy
+    std::vector<float> received[2] = { std::vector<float>(total), std::vector<float>(total) };
+    MPI_Request requests[2] = { MPI_REQUEST_NULL, MPI_REQUEST_NULL };
+    float nothing = 0.0f;
+    auto post = [&](long f) {
+        MPI_Igatherv(&nothing, 0, MPI_FLOAT, received[f % 2].data(), counts.data(), displs.data(), MPI_FLOAT, root,
+                     frames, &requests[f % 2]);
+    };
+
+    FrameReport report = { 0, 0.0, 0.0 };
+    std::vector<float> pixels(static_cast<size_t>(size) * size);
+    const float norm = 1.0f / (scale * scale);
+    if (count > 0) {
+        post(0);
+    }
+    for (long f = 0; f < count; ++f) {
+        double start = MPI_Wtime();
+        MPI_Wait(&requests[f % 2], MPI_STATUS_IGNORE);
+        double arrived = MPI_Wtime();
+        if (f + 1 < count) {
+            post(f + 1);
+        }
+
+        // Pixel rows split between two ranks arrive as two partial sums
+        std::fill(pixels.begin(), pixels.end(), 0.0f);
+        const std::vector<float>& frame = received[f % 2];
+        for (int r = 0; r < root; ++r) {
+            float* target = &pixels[static_cast<size_t>(firstRows[r]) * size];
+            const float* source = &frame[displs[r]];
+            for (int p = 0; p < counts[r]; ++p) {
+                target[p] += source[p];
+            }
+        }
+        for (size_t p = 0; p < pixels.size(); ++p) {
+            pixels[p] *= norm;
+        }
+        video.addFrame(pixels, walls);
+
+        report.waitSeconds += arrived - start;
+        report.convertSeconds += MPI_Wtime() - arrived;
+        ++report.frames;
+    }
+    return report;
+}
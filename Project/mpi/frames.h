@@ -0,0 +1,139 @@
+/**
+ * @file frames.h
+ * @brief Gathers downscaled frames of the distributed field on a dedicated output rank.
+ *
+ * Every compute rank box-sums its own rows into the pixel rows they cover and
+ * hands them to a non-blocking MPI_Igatherv rooted at the output rank, then
+ * goes on stepping. It only waits for a frame when it sends the next one, so
+ * the compute ranks are never more than one frame ahead of the output. A
+ * pixel row that spans two ranks arrives as two partial sums, which the
+ * output rank adds up. The output rank keeps the next gather posted while it
+ * assembles a frame and hands it to a VideoWriter, whose own thread writes it.
+ */
+#ifndef FRAMES_H
+#define FRAMES_H
+
+#include <vector>
+#include <mpi.h>
+#include "ensemble.h"
+#include "geometry.h"
+#include "halo.h"
+#include "video.h"
+
+/**
+ * @brief Returns the pixel rows that grid rows [startRow, startRow + rows) contribute to.
+ *
+ * Grid rows beyond the last whole pixel row are dropped, as in VideoWriter.
+ *
+ * @param startRow First grid row.
+ * @param rows Number of grid rows.
+ * @param scale Downscaling factor.
+ * @param size Pixel rows of a frame.
+ * @param first Receives the first pixel row.
+ * @return Number of pixel rows, 0 if none.
+ */
+int framePixelRows(int startRow, int rows, int scale, int size, int& first);
+
+/**
+ * @brief Returns the number of frames of a run with a frame every `every` steps.
+ *
+ * Frames are taken after steps 1, every + 1, ..., like the OpenMP solver.
+ */
+long frameCount(const Problem& problem, int every);
+
+/**
+ * @brief Returns the fraction of wall cells of every pixel.
+ *
+ * The geometry is rasterized one pixel row at a time, so the mask of the
+ * whole domain is never held.
+ *
+ * @param geometry Walls of the domain.
+ * @param n Grid size.
+ * @param scale Downscaling factor.
+ */
+std::vector<float> wallFractions(const Geometry& geometry, int n, int scale);
+
+/**
+ * @brief Sends the frames of one compute rank.
+ */
+class FrameSender {
+public:
+    FrameSender();
+
+    /**
+     * @brief Waits for the last frame to leave.
+     */
+    ~FrameSender();
+
+    FrameSender(const FrameSender&) = delete;
+    FrameSender& operator=(const FrameSender&) = delete;
+
+    /**
+     * @brief Prepares the send buffer.
+     *
+     * @param frames Communicator of the compute ranks and the output rank.
+     * @param root Rank of the output rank in frames.
+     * @param grid Local grid layout.
+     * @param scale Downscaling factor.
+     */
+    void open(MPI_Comm frames, int root, const LocalGrid& grid, int scale);
+
+    /**
+     * @brief Returns whether frames are sent.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Waits for the previous frame to leave and posts the owned rows of U.
+     *
+     * @param U Grid values with ghost rows.
+     */
+    void send(const std::vector<double>& U);
+
+    /**
+     * @brief Waits for the last frame to leave.
+     */
+    void finish();
+
+    /**
+     * @brief Returns the time spent waiting for frames to leave.
+     */
+    double waitSeconds() const;
+
+private:
+    MPI_Comm comm;
+    int root;
+    LocalGrid grid;
+    int scale;
+    int size;               /**< Pixels per frame row */
+    int firstPixelRow;
+    int pixelRows;
+    std::vector<float> buffer;
+    MPI_Request request;
+    double waited;
+};
+
+/**
+ * @brief Time the output rank spent on the frames.
+ */
+struct FrameReport {
+    long frames;
+    double waitSeconds;    /**< Waiting for the compute ranks */
+    double convertSeconds; /**< Assembling frames and handing them to the writer */
+};
+
+/**
+ * @brief Receives all frames on the output rank and queues them to a video.
+ *
+ * @param frames Communicator of the compute ranks and the output rank, which
+ *               is the last rank and sends nothing.
+ * @param blocks Layout of every compute rank, by rank.
+ * @param scale Downscaling factor.
+ * @param count Number of frames, see frameCount().
+ * @param walls Wall fractions, see wallFractions().
+ * @param video Writer of the frames; if it is not open the frames are received and dropped.
+ */
+FrameReport receiveFrames(MPI_Comm frames, const std::vector<LocalGrid>& blocks, int scale, long count,
+                          const std::vector<float>& walls, VideoWriter& video);
+
+#endif // FRAMES_H
@@ -0,0 +1,79 @@
+/**
+ * @file halo.cpp
+ * @brief Implementation of the ghost row exchange declared in halo.h.
+ */
+
+#include "halo.h"
+
+/**
+ * @brief Builds a datatype covering the same block of rows in two fields.
+ *
+ * The displacements are absolute addresses, so the type is used with MPI_BOTTOM.
+ *
+ * @param first Start of the block in the first field.
+ * @param second Start of the block in the second field.
+ * @param count Number of doubles in each block.
+ */
+static MPI_Datatype createTwoFieldBlock(double* first, double* second, int count) {
+    MPI_Aint displacements[2];
+    MPI_Get_address(first, &displacements[0]);
+    MPI_Get_address(second, &displacements[1]);
+    int lengths[2] = { count, count };
+
+    MPI_Datatype type;
+    MPI_Type_create_hindexed(2, lengths, displacements, MPI_DOUBLE, &type);
+    MPI_Type_commit(&type);
+    return type;
+}
+
+HaloExchange::HaloExchange(MPI_Comm cart, const LocalGrid& grid) : cart(cart), grid(grid) {
+    // Room for the plans of all three buffer pairs, so a plan never moves while
+    // an exchange that uses its datatypes is in flight
+    plans.reserve(3);
+}
+
+HaloExchange::~HaloExchange() {
+    for (size_t p = 0; p < plans.size(); ++p) {
+        for (int n = 0; n < 2; ++n) {
+            MPI_Type_free(&plans[p].sendTypes[n]);
+            MPI_Type_free(&plans[p].recvTypes[n]);
+        }
+    }
+}
+
+const HaloExchange::Plan& HaloExchange::planFor(std::vector<double>& U, std::vector<double>& Uprev) {
+    for (size_t p = 0; p < plans.size(); ++p) {
+        if (plans[p].U == U.data() && plans[p].Uprev == Uprev.data()) {
+            return plans[p];
+        }
+    }
+
+    int count = grid.haloWidth * grid.cols;
+    int topGhost = 0;
+    int topOwned = grid.haloWidth * grid.cols;
+    int bottomOwned = grid.local_N * grid.cols;
+    int bottomGhost = (grid.haloWidth + grid.local_N) * grid.cols;
+
+    // Cartesian neighbours are ordered as the lower (up) then the upper (down) neighbour
+    Plan plan;
+    plan.U = U.data();
+    plan.Uprev = Uprev.data();
+    plan.sendTypes[0] = createTwoFieldBlock(U.data() + topOwned, Uprev.data() + topOwned, count);
+    plan.recvTypes[0] = createTwoFieldBlock(U.data() + topGhost, Uprev.data() + topGhost, count);
+    plan.sendTypes[1] = createTwoFieldBlock(U.data() + bottomOwned, Uprev.data() + bottomOwned, count);
+    plan.recvTypes[1] = createTwoFieldBlock(U.data() + bottomGhost, Uprev.data() + bottomGhost, count);
+    plans.push_back(plan);
+    return plans.back();
+}
+
+// One block per neighbour at MPI_BOTTOM. The argument arrays of a nonblocking
+// collective must stay valid until it completes, so they outlive post()
+static const int neighbourCounts[2] = { 1, 1 };
+static const MPI_Aint neighbourDisplacements[2] = { 0, 0 };
+
+void HaloExchange::post(std::vector<double>& U, std::vector<double>& Uprev, MPI_Request* request) {
+    // The datatypes live in the cached plan, which stays in place until the destructor
+    const Plan& plan = planFor(U, Uprev);
+    MPI_Ineighbor_alltoallw(MPI_BOTTOM, neighbourCounts, neighbourDisplacements, plan.sendTypes,
+                            MPI_BOTTOM, neighbourCounts, neighbourDisplacements, plan.recvTypes, cart, request);
+}
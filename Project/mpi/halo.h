@@ -0,0 +1,82 @@
+/**
+ * @file halo.h
+ * @brief Ghost row exchange of the MPI solver through neighbourhood collectives.
+ *
+ * The processes are arranged in a one-dimensional Cartesian topology along the
+ * rows of the grid. All ghost rows of a process, for both time levels, are
+ * exchanged with a single MPI_Ineighbor_alltoallw described by derived datatypes,
+ * so the MPI library is free to schedule the messages to both neighbours.
+ */
+#ifndef HALO_H
+#define HALO_H
+
+#include <vector>
+#include <mpi.h>
+
+/**
+ * @brief Local part of the grid owned by one process.
+ *
+ * Local row i maps to global row start_row + i - haloWidth. Rows
+ * 0..haloWidth-1 and haloWidth+local_N.. are ghost rows.
+ */
+struct LocalGrid {
+    int local_N;   /**< Number of rows owned by the process */
+    int start_row; /**< Global index of the first owned row */
+    int haloWidth; /**< Number of ghost rows on each side */
+    int rows;      /**< Total number of stored rows, local_N + 2 * haloWidth */
+    int cols;      /**< Number of columns of every row */
+};
+
+/**
+ * @brief Exchanges the ghost rows of the current and previous time level.
+ *
+ * The datatypes address the field buffers directly, so one set is built per
+ * (U, Uprev) buffer pair the first time that pair is exchanged. With the three
+ * rotating time levels of the solver at most three sets are ever built.
+ */
+class HaloExchange {
+public:
+    /**
+     * @brief Creates the exchange for a process of a Cartesian communicator.
+     *
+     * @param cart One-dimensional Cartesian communicator of all processes.
+     * @param grid Local grid layout.
+     */
+    HaloExchange(MPI_Comm cart, const LocalGrid& grid);
+
+    /**
+     * @brief Frees the cached datatypes. Must run before MPI_Finalize.
+     */
+    ~HaloExchange();
+
+    /**
+     * @brief Posts the exchange of haloWidth edge rows of both time levels.
+     *
+     * @param U Current grid values.
+     * @param Uprev Previous grid values.
+     * @param request Request to complete with MPI_Wait.
+     */
+    void post(std::vector<double>& U, std::vector<double>& Uprev, MPI_Request* request);
+
+private:
+    /**
+     * @brief Datatypes for one (U, Uprev) buffer pair, indexed by neighbour.
+     */
+    struct Plan {
+        const double* U;
+        const double* Uprev;
+        MPI_Datatype sendTypes[2];
+        MPI_Datatype recvTypes[2];
+    };
+
+    const Plan& planFor(std::vector<double>& U, std::vector<double>& Uprev);
+
+    MPI_Comm cart;
+    LocalGrid grid;
+    std::vector<Plan> plans;
+
+    HaloExchange(const HaloExchange&);
+    HaloExchange& operator=(const HaloExchange&);
+};
+
+#endif // HALO_H
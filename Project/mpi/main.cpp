@@ -1,16 +1,45 @@
 /**
  * @file main.cpp
  * @brief Solves a partial differential equation using a finite difference method.
- * 
+ *
  * This program solves a partial differential equation using a finite difference method.
  * It initializes a grid, applies boundary conditions, and updates the Laplacian iteratively.
  * The solution is obtained for a given time interval.
+ *
+ * The grid is decomposed into blocks of rows. Each process stores its rows with
+ * haloWidth ghost rows above and below, stored row-major in one contiguous array.
+ * Ghost rows are exchanged every haloWidth steps with one neighbourhood
+ * collective; in between, the shrinking valid part of the ghost region is
+ * updated redundantly so no messages are needed.
+ *
+ * With --ensemble the ranks are split into groups that run many small
+ * problems independently, see ensemble.h. With --video the last rank does not
+ * compute but assembles and writes the frames the others send, see frames.h.
  */
 
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include <mpi.h>
+#include "alloc_counter.h"
+#include "checksum.h"
+#include "ensemble.h"
+#include "frames.h"
+#include "geometry.h"
+#include "halo.h"
+#include "memory.h"
+#include "metrics.h"
+#include "probes.h"
+#include "timing.h"
+#include "trace.h"
+#include "video.h"
 
 // Constants
 const int N = 256;
@@ -18,48 +47,126 @@ const double boxsize = 1.0;
 const double c = 1.0;
 const double tEnd = 2.0;
 
+/**
+ * @brief Command line options of the solver.
+ */
+struct Options {
+    const char* timingCsv;     /**< Per-rank timing CSV file, or nullptr */
+    const char* trace;         /**< Chrome trace file, or nullptr */
+    int haloWidth;             /**< Number of ghost rows per side */
+    std::vector<Probe> probes; /**< Probe locations */
+    std::string probeOutput;   /**< Probe file name, suffixed with the rank */
+    int probeBlock;            /**< Number of steps buffered per probe block */
+    int memoryN;               /**< Grid size to project the memory of, or 0 */
+    std::string metrics;       /**< Live metrics file, suffixed with the rank, or empty */
+    int metricsEvery;          /**< Number of steps between metrics updates */
+    std::string checksums;     /**< Field checksum file written by rank 0, or empty */
+    int checksumEvery;         /**< Number of steps between field checksums */
+    bool report;               /**< Print the timing, memory and allocation reports */
+    std::string video;         /**< Video written by the output rank, or empty */
+    int videoScale;            /**< Downscaling factor of the video frames */
+    int videoEvery;            /**< Number of steps between video frames */
+    Geometry geometry;         /**< Geometry read with --geometry, without shapes if none */
+};
+
+/**
+ * @brief Returns the parameters of the default problem.
+ */
+Problem defaultProblem() {
+    Problem problem;
+    problem.N = N;
+    problem.boxsize = boxsize;
+    problem.c = c;
+    problem.tEnd = tEnd;
+    problem.frequency = 10.0;
+    problem.slitWidth = 1.0 / 16;
+    problem.slitSpacing = 5.0 / 16;
+    return problem;
+}
+
+/**
+ * @brief Splits the rows of an n x n grid into contiguous blocks, one per rank.
+ *
+ * The first n % size ranks own one row more than the others.
+ *
+ * @param n Grid size.
+ * @param haloWidth Number of ghost rows per side.
+ * @param rank Rank in the Cartesian communicator.
+ * @param size Number of ranks of the Cartesian communicator.
+ */
+LocalGrid decompose(int n, int haloWidth, int rank, int size) {
+    LocalGrid grid;
+    int extra = n % size;
+    grid.local_N = n / size + (rank < extra ? 1 : 0);
+    grid.start_row = rank * (n / size) + std::min(rank, extra);
+    grid.haloWidth = haloWidth;
+    grid.rows = grid.local_N + 2 * haloWidth;
+    grid.cols = n;
+    return grid;
+}
+
 /**
  * @brief Initializes the grid and boundary conditions.
- * 
- * @param U Vector of vectors representing the grid values.
- * @param mask Vector of vectors representing the grid mask.
+ *
+ * Only the stored rows of the geometry are rasterized, so no process holds the
+ * mask of the whole domain; the inflow is along global row 0.
+ *
+ * @param U Grid values, rows x cols.
+ * @param mask Grid mask, rows x cols.
  * @param xlin Vector storing the spatial coordinates.
- * @param local_N Number of rows assigned to the current process.
+ * @param grid Local grid layout.
+ * @param problem Problem parameters.
+ * @param geometry Walls of the domain.
  */
-void initializeGrid(std::vector<std::vector<double>>& U, std::vector<std::vector<bool>>& mask, std::vector<double>& xlin, int local_N) {
-    double dx = boxsize / N;
-    for (int i = 0; i < N; ++i) {
+void initializeGrid(std::vector<double>& U, std::vector<bool>& mask, std::vector<double>& xlin, const LocalGrid& grid,
+                    const Problem& problem, const Geometry& geometry) {
+    const int n = grid.cols;
+    double dx = problem.boxsize / n;
+    for (int i = 0; i < n; ++i) {
         xlin[i] = 0.5 * dx + i * dx;
     }
 
-    // Initialize mask based on process's assigned domain
-    for (int i = 0; i < local_N; ++i) {
-        mask[i][0] = true;
-        mask[i][N-1] = true;
+    // Ghost rows outside the domain are walls
+    std::fill(mask.begin(), mask.end(), true);
+    int first = std::max(0, grid.start_row - grid.haloWidth);
+    int last = std::min(n, grid.start_row + grid.local_N + grid.haloWidth);
+    rasterizeRows(geometry, n, first, last - first, mask, static_cast<size_t>(first - grid.start_row + grid.haloWidth) * n);
+}
+
+/**
+ * @brief Returns the geometry of a run: the one read with --geometry, else the slits of the problem.
+ */
+Geometry runGeometry(const Options& options, const Problem& problem) {
+    if (!options.geometry.shapes.empty()) {
+        return options.geometry;
     }
+    return slitGeometry(problem.slitWidth, problem.slitSpacing);
 }
 
 /**
- * @brief Calculates the Laplacian of the grid.
- * 
+ * @brief Calculates the Laplacian of the grid for a range of local rows.
+ *
  * @param U Current grid values.
  * @param Uprev Previous grid values.
  * @param mask Grid mask.
  * @param Unew New grid values after Laplacian calculation.
  * @param fac Factor used in the numerical approximation.
- * @param local_N Number of rows assigned to the current process.
- */
-void calculateLaplacian(std::vector<std::vector<double>>& U, const std::vector<std::vector<double>>& Uprev,
-                        const std::vector<std::vector<bool>>& mask, std::vector<std::vector<double>>& Unew, double fac, int local_N) {
-    for (int i = 1; i < local_N - 1; ++i) {
-        for (int j = 1; j < N - 1; ++j) {
-            if (!mask[i][j]) {
-                double ULX = U[i][j - 1];
-                double URX = U[i][j + 1];
-                double ULY = U[i - 1][j];
-                double URY = U[i + 1][j];
-                double laplacian = (ULX + URX + ULY + URY - 4.0 * U[i][j]);
-                Unew[i][j] = 2.0 * U[i][j] - Uprev[i][j] + fac * laplacian;
+ * @param n Number of columns.
+ * @param first First local row to update.
+ * @param last Last local row to update (inclusive).
+ */
+void calculateLaplacian(const std::vector<double>& U, const std::vector<double>& Uprev,
+                        const std::vector<bool>& mask, std::vector<double>& Unew, double fac, int n, int first, int last) {
+    for (int i = first; i <= last; ++i) {
+        for (int j = 1; j < n - 1; ++j) {
+            int idx = i * n + j;
+            if (!mask[idx]) {
+                double ULX = U[idx - n];
+                double URX = U[idx + n];
+                double ULY = U[idx - 1];
+                double URY = U[idx + 1];
+                double laplacian = (ULX + URX + ULY + URY - 4.0 * U[idx]);
+                Unew[idx] = 2.0 * U[idx] - Uprev[idx] + fac * laplacian;
             }
         }
     }
@@ -67,88 +174,707 @@ void calculateLaplacian(std::vector<std::vector<double>>& U, const std::vector<s
 
 /**
  * @brief Applies boundary conditions to the grid.
- * 
+ *
+ * Conditions are applied to every stored row that lies inside the global domain,
+ * ghost rows included, so that the redundantly updated ghost rows stay identical
+ * to the rows of their owners.
+ *
  * @param U Grid values.
  * @param mask Grid mask.
  * @param xlin Vector storing the spatial coordinates.
  * @param t Current time.
- * @param local_N Number of rows assigned to the current process.
+ * @param grid Local grid layout.
+ * @param frequency Frequency of the inflow source.
  */
-void applyBoundaryConditions(std::vector<std::vector<double>>& U, const std::vector<std::vector<bool>>& mask, std::vector<double>& xlin, double t, int local_N) {
-    for (int i = 0; i < local_N; ++i) {
-        U[i][0] = U[i][N - 1] = 0.0;
+void applyBoundaryConditions(std::vector<double>& U, const std::vector<bool>& mask, const std::vector<double>& xlin, double t, const LocalGrid& grid,
+                             double frequency) {
+    const int n = grid.cols;
+    int first = std::max(0, grid.haloWidth - grid.start_row);
+    int last = std::min(grid.rows - 1, grid.haloWidth + n - 1 - grid.start_row);
+
+    for (int i = first; i <= last; ++i) {
+        U[i * n] = U[i * n + n - 1] = 0.0;
     }
 
-    for (int i = 0; i < local_N; ++i) {
-        U[i][0] = std::sin(20.0 * M_PI * t) * std::pow(std::sin(M_PI * xlin[i]), 2);
+    // The last global row is a wall, the first one the inflow
+    int bottom = grid.haloWidth + n - 1 - grid.start_row;
+    if (bottom >= first && bottom <= last) {
+        std::fill(U.begin() + bottom * n, U.begin() + (bottom + 1) * n, 0.0);
+    }
+    int top = grid.haloWidth - grid.start_row;
+    if (top >= first && top <= last) {
+        for (int j = 0; j < n; ++j) {
+            U[top * n + j] = std::sin(2.0 * frequency * M_PI * t) * std::pow(std::sin(M_PI * xlin[j]), 2);
+        }
     }
 }
 
-int main(int argc, char* argv[]) {
-    MPI_Init(&argc, &argv);
+/**
+ * @brief Returns the checksum of the rows owned by the process.
+ *
+ * @param U Grid values.
+ * @param grid Local grid layout.
+ * @param step Steps taken.
+ */
+FieldChecksum ownedChecksum(const std::vector<double>& U, const LocalGrid& grid, long long step) {
+    FieldChecksum checksum = emptyChecksum(step);
+    for (int i = 0; i < grid.local_N; ++i) {
+        addRow(checksum, grid.start_row + i, &U[(grid.haloWidth + i) * grid.cols], grid.cols);
+    }
+    return checksum;
+}
 
-    int rank, size;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    MPI_Comm_size(MPI_COMM_WORLD, &size);
+/**
+ * @brief Adds the checksum of the owned rows of all processes on rank 0.
+ *
+ * The hashes add up modulo 2^64, so the order of the reduction does not matter.
+ *
+ * @param U Grid values.
+ * @param grid Local grid layout.
+ * @param step Steps taken.
+ * @param cart Communicator of the run.
+ * @param checksums Receives the checksum on rank 0.
+ */
+void gatherChecksum(const std::vector<double>& U, const LocalGrid& grid, long long step, MPI_Comm cart,
+                    std::vector<FieldChecksum>& checksums) {
+    FieldChecksum local = ownedChecksum(U, grid, step);
+    FieldChecksum total = emptyChecksum(step);
+    double moments[2] = { local.sum, local.energy };
+    double totals[2] = { 0.0, 0.0 };
+    MPI_Reduce(&local.hash, &total.hash, 1, MPI_UINT64_T, MPI_SUM, 0, cart);
+    MPI_Reduce(moments, totals, 2, MPI_DOUBLE, MPI_SUM, 0, cart);
+    total.sum = totals[0];
+    total.energy = totals[1];
+
+    int rank;
+    MPI_Comm_rank(cart, &rank);
+    if (rank == 0) {
+        checksums.push_back(total);
+    }
+}
 
+/**
+ * @brief Returns the sum of U^2 over the rows owned by the process.
+ *
+ * @param U Grid values.
+ * @param grid Local grid layout.
+ */
+double ownedEnergy(const std::vector<double>& U, const LocalGrid& grid) {
+    double energy = 0.0;
+    for (int i = grid.haloWidth * grid.cols; i < (grid.haloWidth + grid.local_N) * grid.cols; ++i) {
+        energy += U[i] * U[i];
+    }
+    return energy;
+}
+
+/**
+ * @brief Returns the rows stored by the largest rank of decompose(), ghost rows included.
+ */
+int peakStoredRows(int n, int ranks, int haloWidth) {
+    return (n + ranks - 1) / ranks + 2 * haloWidth;
+}
+
+/**
+ * @brief Returns the memory the fields of the largest rank will take.
+ *
+ * The first n % ranks ranks own one row more than the others; the largest
+ * rank decides whether a run fits.
+ *
+ * @param n Grid size.
+ * @param ranks Number of ranks.
+ * @param haloWidth Number of ghost rows per side.
+ */
+MemoryReport projectMemory(int n, int ranks, int haloWidth) {
+    int rows = peakStoredRows(n, ranks, haloWidth);
+    MemoryReport report;
+    report.add("U", flatDoubleBytes(rows, n));
+    report.add("Uprev", flatDoubleBytes(rows, n));
+    report.add("Unew", flatDoubleBytes(rows, n));
+    report.add("mask", flatMaskBytes(rows, n));
+    report.add("xlin", flatDoubleBytes(1, n));
+    return report;
+}
+
+/**
+ * @brief Runs the simulation on the local part of the grid and reports the timings.
+ *
+ * Every rank records the probes whose interpolation stencil starts in its rows
+ * into its own file, sampling the field at the start of every step when at
+ * least one ghost row is valid.
+ *
+ * @param cart Cartesian communicator of all processes of the run.
+ * @param grid Local grid layout.
+ * @param options Command line options.
+ * @param problem Problem parameters.
+ * @param frames Communicator of the ranks of cart followed by the output rank,
+ *               or MPI_COMM_NULL without video.
+ * @return Summary of the run, valid on rank 0 of cart.
+ */
+RunSummary simulate(MPI_Comm cart, const LocalGrid& grid, const Options& options, const Problem& problem,
+                    MPI_Comm frames = MPI_COMM_NULL) {
     // Start the timer
     double start_time = MPI_Wtime();
 
-    // Determine the domain size for each process
-    int local_N = N / size;
-    int start_row = rank * local_N;
-    int end_row = (rank + 1) * local_N;
-
     // Simulation parameters
-    double dx = boxsize / N;
-    double dt = (std::sqrt(2)/2) * dx / c;
-    double fac = dt*dt * c*c / (dx*dx);
+    const int n = grid.cols;
+    double dx = problem.boxsize / n;
+    double dt = (std::sqrt(2)/2) * dx / problem.c;
+    double fac = dt*dt * problem.c*problem.c / (dx*dx);
+
+    std::vector<double> xlin(n);
+    std::vector<double> U(grid.rows * n, 0.0);
+    std::vector<bool> mask(grid.rows * n, false);
+    std::vector<double> Uprev(grid.rows * n, 0.0);
+    std::vector<double> Unew(grid.rows * n, 0.0);
+
+    initializeGrid(U, mask, xlin, grid, problem, runGeometry(options, problem));
 
-    std::vector<double> xlin(N);
-    std::vector<std::vector<double>> U(local_N, std::vector<double>(N, 0.0));
-    std::vector<std::vector<bool>> mask(local_N, std::vector<bool>(N, false));
-    std::vector<std::vector<double>> Uprev(local_N, std::vector<double>(N, 0.0));
-    std::vector<std::vector<double>> Unew(local_N, std::vector<double>(N, 0.0));
+    // Local rows that hold the global interior (global rows 0 and n-1 are fixed)
+    int haloWidth = grid.haloWidth;
+    int interior_first = std::max(1, haloWidth + 1 - grid.start_row);
+    int interior_last = std::min(grid.rows - 2, haloWidth + n - 2 - grid.start_row);
 
-    initializeGrid(U, mask, xlin, local_N);
+    // Owned rows that can be updated before the ghost rows arrive
+    int owned_first = std::max(haloWidth + 1, interior_first);
+    int owned_last = std::min(haloWidth + grid.local_N - 2, interior_last);
 
+    int rank;
+    MPI_Comm_rank(cart, &rank);
+    ProbeRecorder probes(options.probes, n, problem.boxsize, dt, grid.start_row, grid.start_row + grid.local_N - 1, options.probeBlock);
+    if (probes.size() > 0) {
+        probes.open(options.probeOutput + "." + std::to_string(rank));
+    }
+    auto field = [&](int i, int j) { return U[(i - grid.start_row + grid.haloWidth) * n + j]; };
+
+    PhaseTimer timer;
+
+    // Live metrics are only published every metricsEvery steps and need no communication
+    int ranks;
+    MPI_Comm_size(cart, &ranks);
+    MetricsWriter metrics;
+    if (!options.metrics.empty()
+        && !metrics.open(options.metrics + "." + std::to_string(rank), rank, ranks, problem.tEnd)) {
+        std::cerr << "Could not open " << options.metrics << "." << rank << std::endl;
+    }
+    auto metricsSample = [&](int steps, double time) {
+        MetricsSample sample;
+        sample.step = steps;
+        sample.time = time;
+        sample.stepRate = 0.0;
+        sample.energy = ownedEnergy(U, grid);
+        sample.computeSeconds = timer.elapsed(PHASE_COMPUTE);
+        sample.waitSeconds = timer.elapsed(PHASE_HALO_WAIT);
+        sample.imbalance = 1.0;
+        return sample;
+    };
+
+    // Frames leave with a non-blocking gather; only the previous one is waited for
+    FrameSender frameSender;
+    if (frames != MPI_COMM_NULL) {
+        int frameRanks;
+        MPI_Comm_size(frames, &frameRanks);
+        frameSender.open(frames, frameRanks - 1, grid, options.videoScale);
+    }
+
+    HaloExchange halo(cart, grid);
+    MPI_Request request;
     double t = 0.0;
+    int step = 0;
+
+    // Halo plans are built on the first exchange of each of the three buffer
+    // pairs, so the loop must not allocate after three exchanges
+    const int warmupSteps = 3 * grid.haloWidth;
+    long long warmupAllocations = 0;
 
-    while (t < tEnd) {
-        // calculate laplacian
-        calculateLaplacian(U, Uprev, mask, Unew, fac, local_N);
+    // Checksums are reserved up front for the same reason
+    std::vector<FieldChecksum> checksums;
+    if (!options.checksums.empty()) {
+        checksums.reserve(static_cast<size_t>(problem.tEnd / dt) / options.checksumEvery + 3);
+        gatherChecksum(U, grid, step, cart, checksums);
+    }
+
+    while (t < problem.tEnd) {
+        if (step == warmupSteps) {
+            warmupAllocations = allocationCount();
+        }
 
-        Uprev = U;
-        U = Unew;
+        // every haloWidth steps the ghost region is refreshed; afterwards its
+        // valid part shrinks by one row per step on each side
+        int sub_step = step % haloWidth;
+        int first = std::max(interior_first, 1 + sub_step);
+        int last = std::min(interior_last, grid.rows - 2 - sub_step);
+
+        if (sub_step == 0) {
+            timer.start(PHASE_HALO_POST);
+            halo.post(U, Uprev, &request);
+            timer.stop(PHASE_HALO_POST);
+
+            // exchange ghost rows while the rows that do not depend on them are updated
+            timer.start(PHASE_COMPUTE);
+            calculateLaplacian(U, Uprev, mask, Unew, fac, n, owned_first, owned_last);
+            timer.stop(PHASE_COMPUTE);
+
+            timer.start(PHASE_HALO_WAIT);
+            MPI_Wait(&request, MPI_STATUS_IGNORE);
+            timer.stop(PHASE_HALO_WAIT);
+
+            // calculate laplacian of the rows that depend on the ghost rows
+            timer.start(PHASE_COMPUTE);
+            if (owned_first <= owned_last) {
+                calculateLaplacian(U, Uprev, mask, Unew, fac, n, first, owned_first - 1);
+                calculateLaplacian(U, Uprev, mask, Unew, fac, n, owned_last + 1, last);
+            } else {
+                calculateLaplacian(U, Uprev, mask, Unew, fac, n, first, last);
+            }
+        } else {
+            timer.start(PHASE_COMPUTE);
+            calculateLaplacian(U, Uprev, mask, Unew, fac, n, first, last);
+        }
+        timer.stop(PHASE_COMPUTE);
+
+        // sample the probes before the current time level is rotated away
+        timer.start(PHASE_IO);
+        probes.sampleAll(field);
+        probes.endStep();
+        timer.stop(PHASE_IO);
+
+        timer.start(PHASE_COMPUTE);
+        Uprev.swap(U);
+        U.swap(Unew);
+        timer.stop(PHASE_COMPUTE);
 
         // apply boundary conditions (Dirichlet/inflow)
-        applyBoundaryConditions(U, mask, xlin, t, local_N);
+        timer.start(PHASE_BOUNDARY);
+        applyBoundaryConditions(U, mask, xlin, t, grid, problem.frequency);
+        timer.stop(PHASE_BOUNDARY);
 
         t += dt;
+        ++step;
+
+        if (metrics.isOpen() && step % options.metricsEvery == 0) {
+            timer.start(PHASE_IO);
+            metrics.publish(metricsSample(step, t));
+            timer.stop(PHASE_IO);
+        }
+
+        if (!options.checksums.empty() && (step % options.checksumEvery == 0 || t >= problem.tEnd)) {
+            timer.start(PHASE_IO);
+            gatherChecksum(U, grid, step, cart, checksums);
+            timer.stop(PHASE_IO);
+        }
+
+        // Frames of the same steps as the OpenMP solver
+        if (frameSender.isOpen() && (step - 1) % options.videoEvery == 0) {
+            timer.start(PHASE_IO);
+            frameSender.send(U);
+            timer.stop(PHASE_IO);
+        }
     }
 
+    timer.start(PHASE_IO);
+    frameSender.finish();
+    probes.flush();
+    metrics.finish(metricsSample(step, t));
+    timer.stop(PHASE_IO);
+
     // Stop the timer and calculate the elapsed time
     double end_time = MPI_Wtime();
+    long long loopAllocations = step > warmupSteps ? allocationCount() - warmupAllocations : 0;
     double elapsed_time = end_time - start_time;
 
-    // Gather the elapsed times from all processes to the root process
-    std::vector<double> all_times;
-    if (rank == 0) {
-        all_times.resize(size);
+    if (rank == 0 && !options.checksums.empty() && !writeChecksums(options.checksums, checksums)) {
+        std::cerr << "Could not write " << options.checksums << std::endl;
     }
-    MPI_Gather(&elapsed_time, 1, MPI_DOUBLE, all_times.data(), 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 
-    // Print the elapsed times for all processes on the root process
+    // Summary of the run on rank 0
+    RunSummary summary;
+    summary.ranks = ranks;
+    summary.steps = step;
+    double local[2] = { ownedEnergy(U, grid), 0.0 };
+    for (int i = haloWidth * n; i < (haloWidth + grid.local_N) * n; ++i) {
+        local[1] = std::max(local[1], std::fabs(U[i]));
+    }
+    double compute = timer.elapsed(PHASE_COMPUTE);
+    double computeSum = 0.0, computeMax = 0.0;
+    MPI_Reduce(&local[0], &summary.energy, 1, MPI_DOUBLE, MPI_SUM, 0, cart);
+    MPI_Reduce(&local[1], &summary.maxAmplitude, 1, MPI_DOUBLE, MPI_MAX, 0, cart);
+    MPI_Reduce(&elapsed_time, &summary.seconds, 1, MPI_DOUBLE, MPI_MAX, 0, cart);
+    MPI_Reduce(&compute, &computeSum, 1, MPI_DOUBLE, MPI_SUM, 0, cart);
+    MPI_Reduce(&compute, &computeMax, 1, MPI_DOUBLE, MPI_MAX, 0, cart);
+    summary.imbalance = computeSum > 0.0 ? computeMax * ranks / computeSum : 1.0;
+
+    if (options.report) {
+        // Reduce the phase times of all processes into min/avg/max on the root process
+        reportPhaseTimes(timer, elapsed_time, cart, options.timingCsv);
+    }
+
+    if (options.report && options.memoryN > 0) {
+        // Ghost rows are included in the cell count, so bytes per cell show their overhead
+        MemoryReport report;
+        report.add("U", bytesOf(U));
+        report.add("Uprev", bytesOf(Uprev));
+        report.add("Unew", bytesOf(Unew));
+        report.add("mask", bytesOf(mask));
+        report.add("xlin", bytesOf(xlin));
+
+        unsigned long long peak = peakResidentBytes();
+        unsigned long long maxPeak = 0, sumPeak = 0;
+        MPI_Reduce(&peak, &maxPeak, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, 0, cart);
+        MPI_Reduce(&peak, &sumPeak, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, cart);
+        if (rank == 0) {
+            report.print(std::cout, "Allocated memory per rank", static_cast<size_t>(grid.rows) * n);
+            std::printf("Peak RSS: %.3f MiB max per rank, %.3f MiB over all ranks\n", maxPeak / 1048576.0,
+                        sumPeak / 1048576.0);
+        }
+    }
+    if (options.report && allocationCountingEnabled) {
+        long long totalAllocations = 0;
+        MPI_Reduce(&loopAllocations, &totalAllocations, 1, MPI_LONG_LONG, MPI_SUM, 0, cart);
+        if (rank == 0) {
+            std::cout << "Heap allocations in the time loop after warm-up: " << totalAllocations << std::endl;
+        }
+    }
+
+    if (options.report && frameSender.isOpen()) {
+        double waited = frameSender.waitSeconds();
+        double maxWaited = 0.0;
+        MPI_Reduce(&waited, &maxWaited, 1, MPI_DOUBLE, MPI_MAX, 0, cart);
+        if (rank == 0) {
+            std::printf("Frames: compute ranks waited at most %.3f s for the output rank\n", maxWaited);
+        }
+    }
+
+    if (traceEnabled && options.trace != nullptr) {
+        writeTrace(cart, options.trace);
+        // A group runs its ensemble members one after another, each into its own file
+        traceClear();
+    }
+    return summary;
+}
+
+/**
+ * @brief Runs the output rank: receives the frames of the compute ranks and writes the video.
+ *
+ * @param frames Communicator of the compute ranks followed by this rank.
+ * @param computeRanks Number of compute ranks.
+ * @param options Command line options.
+ * @param problem Problem parameters.
+ */
+void writeFrames(MPI_Comm frames, int computeRanks, const Options& options, const Problem& problem) {
+    const int n = problem.N;
+    std::vector<LocalGrid> blocks;
+    for (int r = 0; r < computeRanks; ++r) {
+        blocks.push_back(decompose(n, options.haloWidth, r, computeRanks));
+    }
+
+    // Without an output file the frames are still received, so the compute ranks do not hang
+    VideoWriter video(n, options.videoScale, 30);
+    video.open(options.video);
+    FrameReport report = receiveFrames(frames, blocks, options.videoScale, frameCount(problem, options.videoEvery),
+                                       wallFractions(runGeometry(options, problem), n, options.videoScale), video);
+    video.close();
+    std::fprintf(stderr, "Output rank: %ld frames of %dx%d pixels, %.3f s waiting for frames, %.3f s converting\n",
+                 report.frames, video.frameSize(), video.frameSize(), report.waitSeconds, report.convertSeconds);
+}
+
+/**
+ * @brief Creates a non-periodic line of the processes of comm along the rows of the grid.
+ *
+ * @param comm Communicator of the processes.
+ * @param reorder Let MPI renumber the processes; pass false when another
+ *        communicator relies on the rank in comm owning the same block.
+ */
+MPI_Comm createCart(MPI_Comm comm, bool reorder = true) {
+    int size;
+    MPI_Comm_size(comm, &size);
+    MPI_Comm cart;
+    int dims[1] = { size };
+    int periods[1] = { 0 };
+    MPI_Cart_create(comm, 1, dims, periods, reorder ? 1 : 0, &cart);
+    return cart;
+}
+
+/**
+ * @brief Reads a geometry file on rank 0 of comm and parses it on every rank.
+ *
+ * Only the description travels; every rank later reads just the rows of a
+ * bitmap that it stores.
+ *
+ * @param path Path of the geometry file.
+ * @param comm Communicator of all processes.
+ * @param geometry Receives the shapes.
+ * @return false on every rank if the file could not be read or parsed.
+ */
+bool loadGeometry(const std::string& path, MPI_Comm comm, Geometry& geometry) {
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    std::string text;
+    long length = -1;
     if (rank == 0) {
-        double totalExecutionTime = 0.0;
-        for (int i = 0; i < size; ++i) {
-            std::cout << "Process " << i << " Execution Time: " << all_times[i] << " seconds" << std::endl;
-            totalExecutionTime += all_times[i];
+        std::ifstream in(path.c_str());
+        if (in) {
+            std::stringstream contents;
+            contents << in.rdbuf();
+            text = contents.str();
+            length = static_cast<long>(text.size());
+        }
+    }
+    MPI_Bcast(&length, 1, MPI_LONG, 0, comm);
+    if (length < 0) {
+        if (rank == 0) {
+            std::cerr << "Could not read geometry from " << path << std::endl;
         }
-        std::cout << "Total Execution Time: " << totalExecutionTime << " seconds" << std::endl;
+        return false;
     }
+    text.resize(length);
+    MPI_Bcast(&text[0], static_cast<int>(length), MPI_CHAR, 0, comm);
 
-    MPI_Finalize();
+    // A bitmap may be unreadable on some ranks only, so all agree on the outcome
+    std::string error;
+    int ok = parseGeometry(text, directoryOf(path), geometry, error) ? 1 : 0;
+    int allOk = 0;
+    MPI_Allreduce(&ok, &allOk, 1, MPI_INT, MPI_MIN, comm);
+    if (!ok) {
+        std::cerr << "Rank " << rank << ": " << path << ": " << error << std::endl;
+    }
+    return allOk == 1;
+}
+
+/**
+ * @brief Checks that every rank of a decomposition can fill its ghost rows from its direct neighbours.
+ *
+ * @param n Grid size.
+ * @param haloWidth Number of ghost rows per side.
+ * @param ranks Number of ranks.
+ */
+bool validHaloWidth(int n, int haloWidth, int ranks) {
+    return haloWidth >= 1 && haloWidth <= n / ranks;
+}
+
+/**
+ * @brief Runs every member of an ensemble on its group of ranks.
+ *
+ * MPI_COMM_WORLD is split into min(members, size) groups of contiguous ranks.
+ * Group g runs the members g, g + groups, ... one after another, each on a
+ * Cartesian communicator of its own. Output files of member m get the suffix
+ * .m<m> before the rank.
+ *
+ * @param members Problems of all members.
+ * @param options Command line options.
+ * @param csvPath CSV file of the summaries, or nullptr.
+ * @return Exit code.
+ */
+int runEnsemble(const std::vector<Problem>& members, const Options& options, const char* csvPath) {
+    int worldRank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    int members_count = static_cast<int>(members.size());
+    int groups = std::min(members_count, size);
+    int group = ensembleGroup(worldRank, size, groups);
+    MPI_Comm groupComm;
+    MPI_Comm_split(MPI_COMM_WORLD, group, worldRank, &groupComm);
+    MPI_Comm cart = createCart(groupComm);
+
+    int rank, ranks;
+    MPI_Comm_rank(cart, &rank);
+    MPI_Comm_size(cart, &ranks);
+    if (worldRank == 0) {
+        std::cout << "Ensemble: " << members_count << " members on " << groups << " groups of "
+                  << size / groups << (size % groups != 0 ? "+" : "") << " ranks" << std::endl;
+    }
+
+    RunSummary none = { 0, 0, 0.0, 0.0, 0.0, 0.0 };
+    std::vector<RunSummary> summaries(members.size(), none);
+    for (int m = group; m < members_count; m += groups) {
+        const Problem& problem = members[m];
+        if (!validHaloWidth(problem.N, options.haloWidth, ranks)) {
+            if (rank == 0) {
+                std::cerr << "Member " << m << ": halo width must be between 1 and " << problem.N / ranks << std::endl;
+            }
+            continue;
+        }
+
+        // Members share the output options, so their files are told apart by a suffix
+        std::string suffix = ".m" + std::to_string(m);
+        Options memberOptions = options;
+        memberOptions.report = false;
+        memberOptions.probeOutput += suffix;
+        if (!options.metrics.empty()) {
+            memberOptions.metrics += suffix;
+        }
+        if (!options.checksums.empty()) {
+            memberOptions.checksums += suffix;
+        }
+        std::string trace = options.trace != nullptr ? options.trace + suffix : std::string();
+        memberOptions.trace = options.trace != nullptr ? trace.c_str() : nullptr;
+
+        LocalGrid grid = decompose(problem.N, options.haloWidth, rank, ranks);
+        RunSummary summary = simulate(cart, grid, memberOptions, problem);
+        if (rank == 0) {
+            summaries[m] = summary;
+        }
+    }
+
+    reportEnsemble(MPI_COMM_WORLD, members, summaries, csvPath);
+
+    MPI_Comm_free(&cart);
+    MPI_Comm_free(&groupComm);
     return 0;
 }
 
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Optional arguments: --timing-csv <file> --halo-width <k>
+    //                     --probes <file> --probe-output <file> --probe-block <steps>
+    //                     --trace <file> --memory <n> --metrics <file> --metrics-every <steps>
+    //                     --ensemble <file> --ensemble-csv <file>
+    //                     --checksums <file> --checksum-every <steps>
+    //                     --video <file> --video-scale <factor> --video-every <steps>
+    //                     --geometry <file>
+    Options options;
+    options.timingCsv = nullptr;
+    options.trace = nullptr;
+    options.haloWidth = 1;
+    options.probeOutput = "probes.bin";
+    options.probeBlock = 4096;
+    options.memoryN = 0;
+    options.metricsEvery = 100;
+    options.checksumEvery = 10;
+    options.report = true;
+    options.videoScale = 1;
+    options.videoEvery = 10;
+    const char* ensemble = nullptr;
+    const char* ensembleCsv = nullptr;
+    const char* geometry = nullptr;
+    for (int a = 1; a < argc - 1; ++a) {
+        if (std::strcmp(argv[a], "--timing-csv") == 0) {
+            options.timingCsv = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--trace") == 0) {
+            options.trace = argv[a + 1];
+            if (!traceEnabled && rank == 0) {
+                std::cerr << "Tracing is not compiled in, rebuild with make TRACE=1" << std::endl;
+            }
+        } else if (std::strcmp(argv[a], "--halo-width") == 0) {
+            options.haloWidth = std::atoi(argv[a + 1]);
+        } else if (std::strcmp(argv[a], "--probes") == 0) {
+            if (!readProbes(argv[a + 1], options.probes) && rank == 0) {
+                std::cerr << "Could not read probes from " << argv[a + 1] << std::endl;
+            }
+        } else if (std::strcmp(argv[a], "--probe-output") == 0) {
+            options.probeOutput = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--probe-block") == 0) {
+            options.probeBlock = std::max(1, std::atoi(argv[a + 1]));
+        } else if (std::strcmp(argv[a], "--memory") == 0) {
+            options.memoryN = std::atoi(argv[a + 1]);
+        } else if (std::strcmp(argv[a], "--metrics") == 0) {
+            options.metrics = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--metrics-every") == 0) {
+            options.metricsEvery = std::max(1, std::atoi(argv[a + 1]));
+        } else if (std::strcmp(argv[a], "--checksums") == 0) {
+            options.checksums = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--checksum-every") == 0) {
+            options.checksumEvery = std::max(1, std::atoi(argv[a + 1]));
+        } else if (std::strcmp(argv[a], "--video") == 0) {
+            options.video = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--video-scale") == 0) {
+            options.videoScale = std::max(1, std::atoi(argv[a + 1]));
+        } else if (std::strcmp(argv[a], "--video-every") == 0) {
+            options.videoEvery = std::max(1, std::atoi(argv[a + 1]));
+        } else if (std::strcmp(argv[a], "--geometry") == 0) {
+            geometry = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--ensemble") == 0) {
+            ensemble = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--ensemble-csv") == 0) {
+            ensembleCsv = argv[a + 1];
+        }
+    }
+    int haloWidth = options.haloWidth;
+    Problem problem = defaultProblem();
+    if (geometry != nullptr && !loadGeometry(geometry, MPI_COMM_WORLD, options.geometry)) {
+        MPI_Finalize();
+        return 1;
+    }
+
+    if (ensemble != nullptr) {
+        if (!options.video.empty() && rank == 0) {
+            std::cerr << "--video is ignored for ensembles" << std::endl;
+        }
+
+        // Every rank reads the specification, so all agree on the members
+        std::vector<Problem> members;
+        int status = 1;
+        if (readEnsemble(ensemble, problem, members) && !members.empty()) {
+            status = runEnsemble(members, options, ensembleCsv);
+        }
+        MPI_Finalize();
+        return status;
+    }
+
+    // With a video the last rank only writes frames and the others compute
+    bool video = !options.video.empty();
+    if (video && size < 2) {
+        std::cerr << "--video needs a rank for the output besides the compute ranks" << std::endl;
+        MPI_Finalize();
+        return 1;
+    }
+    int computeRanks = video ? size - 1 : size;
+    bool outputRank = video && rank == size - 1;
+
+    // Ghost rows can only be filled from the direct neighbours
+    if (!validHaloWidth(problem.N, haloWidth, computeRanks)) {
+        if (rank == 0) {
+            std::cerr << "Halo width must be between 1 and " << problem.N / computeRanks << std::endl;
+        }
+        MPI_Finalize();
+        return 1;
+    }
+
+    // Project the memory before allocating; for any other n than N stop there
+    if (options.memoryN > 0) {
+        int memoryN = options.memoryN;
+        if (rank == 0) {
+            size_t cells = static_cast<size_t>(peakStoredRows(memoryN, computeRanks, haloWidth)) * memoryN;
+            projectMemory(memoryN, computeRanks, haloWidth).print(std::cout, "Projected memory of the largest rank for N = "
+                + std::to_string(memoryN), cells);
+        }
+        if (memoryN != problem.N) {
+            MPI_Finalize();
+            return 0;
+        }
+    }
+
+    // The frames travel on a communicator of their own, with the output rank last
+    MPI_Comm computeComm = MPI_COMM_WORLD;
+    MPI_Comm frames = MPI_COMM_NULL;
+    if (video) {
+        MPI_Comm_dup(MPI_COMM_WORLD, &frames);
+        MPI_Comm_split(MPI_COMM_WORLD, outputRank ? 1 : 0, rank, &computeComm);
+    }
+
+    if (outputRank) {
+        writeFrames(frames, computeRanks, options, problem);
+    } else {
+        // Arrange the processes in a non-periodic line along the rows of the grid. The
+        // output rank expects rank r of frames to own block r, so keep the ranks then
+        MPI_Comm cart = createCart(computeComm, !video);
+        MPI_Comm_rank(cart, &rank);
+
+        // Determine the domain size for each process
+        LocalGrid grid = decompose(problem.N, haloWidth, rank, computeRanks);
+        simulate(cart, grid, options, problem, frames);
+        MPI_Comm_free(&cart);
+    }
+
+    if (video) {
+        MPI_Comm_free(&computeComm);
+        MPI_Comm_free(&frames);
+    }
+    MPI_Finalize();
+    return 0;
+}
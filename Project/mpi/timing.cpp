@@ -0,0 +1,137 @@
+/**
+ * @file timing.cpp
+ * @brief Implementation of the per-phase timers declared in timing.h.
+ */
+
+#include "timing.h"
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "trace.h"
+
+PhaseTimer::PhaseTimer() {
+    for (int p = 0; p < NUM_PHASES; ++p) {
+        started[p] = 0.0;
+        total[p] = 0.0;
+        traceStarted[p] = 0;
+    }
+}
+
+void PhaseTimer::start(Phase phase) {
+    started[phase] = MPI_Wtime();
+    traceStarted[phase] = traceNow();
+}
+
+void PhaseTimer::stop(Phase phase) {
+    total[phase] += MPI_Wtime() - started[phase];
+    traceRecord(phaseName(phase), traceStarted[phase], traceNow());
+}
+
+double PhaseTimer::elapsed(Phase phase) const {
+    return total[phase];
+}
+
+const char* phaseName(Phase phase) {
+    switch (phase) {
+        case PHASE_COMPUTE:   return "compute";
+        case PHASE_HALO_POST: return "halo_post";
+        case PHASE_HALO_WAIT: return "halo_wait";
+        case PHASE_BOUNDARY:  return "boundary";
+        case PHASE_IO:        return "io";
+        default:              return "unknown";
+    }
+}
+
+void reportPhaseTimes(const PhaseTimer& timer, double wallTime, MPI_Comm comm, const char* csvPath) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    // The last slot holds the total wall time so it is reduced alongside the phases
+    const int numValues = NUM_PHASES + 1;
+    double local[numValues];
+    for (int p = 0; p < NUM_PHASES; ++p) {
+        local[p] = timer.elapsed(static_cast<Phase>(p));
+    }
+    local[NUM_PHASES] = wallTime;
+
+    double minTimes[numValues], maxTimes[numValues], sumTimes[numValues];
+    MPI_Reduce(local, minTimes, numValues, MPI_DOUBLE, MPI_MIN, 0, comm);
+    MPI_Reduce(local, maxTimes, numValues, MPI_DOUBLE, MPI_MAX, 0, comm);
+    MPI_Reduce(local, sumTimes, numValues, MPI_DOUBLE, MPI_SUM, 0, comm);
+
+    if (rank == 0) {
+        std::printf("%-10s %12s %12s %12s %10s\n", "Phase", "Min [s]", "Avg [s]", "Max [s]", "Imbalance");
+        for (int p = 0; p < numValues; ++p) {
+            const char* name = p < NUM_PHASES ? phaseName(static_cast<Phase>(p)) : "total";
+            double avg = sumTimes[p] / size;
+            double imbalance = avg > 0.0 ? maxTimes[p] / avg : 1.0;
+            std::printf("%-10s %12.6f %12.6f %12.6f %10.3f\n", name, minTimes[p], avg, maxTimes[p], imbalance);
+        }
+    }
+
+    if (csvPath == nullptr) {
+        return;
+    }
+
+    std::vector<double> all;
+    if (rank == 0) {
+        all.resize(static_cast<size_t>(numValues) * size);
+    }
+    MPI_Gather(local, numValues, MPI_DOUBLE, all.data(), numValues, MPI_DOUBLE, 0, comm);
+
+    if (rank == 0) {
+        FILE* file = std::fopen(csvPath, "w");
+        if (file == nullptr) {
+            std::cerr << "Could not open " << csvPath << " for writing" << std::endl;
+            return;
+        }
+        std::fprintf(file, "rank");
+        for (int p = 0; p < NUM_PHASES; ++p) {
+            std::fprintf(file, ",%s", phaseName(static_cast<Phase>(p)));
+        }
+        std::fprintf(file, ",total\n");
+        for (int r = 0; r < size; ++r) {
+            std::fprintf(file, "%d", r);
+            for (int p = 0; p < numValues; ++p) {
+                std::fprintf(file, ",%.9f", all[static_cast<size_t>(r) * numValues + p]);
+            }
+            std::fprintf(file, "\n");
+        }
+        std::fclose(file);
+    }
+}
+
+void writeTrace(MPI_Comm comm, const char* path) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    std::string events = traceEvents(rank, "rank " + std::to_string(rank));
+    int length = static_cast<int>(events.size());
+    std::vector<int> lengths(size), offsets(size, 0);
+    MPI_Gather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, 0, comm);
+
+    std::vector<char> all;
+    if (rank == 0) {
+        for (int r = 1; r < size; ++r) {
+            offsets[r] = offsets[r - 1] + lengths[r - 1];
+        }
+        all.resize(offsets[size - 1] + lengths[size - 1]);
+    }
+    MPI_Gatherv(&events[0], length, MPI_CHAR, all.data(), lengths.data(), offsets.data(), MPI_CHAR, 0, comm);
+
+    if (rank == 0) {
+        std::string merged;
+        for (int r = 0; r < size; ++r) {
+            if (lengths[r] > 0) {
+                merged += merged.empty() ? "" : ",\n";
+                merged.append(all.data() + offsets[r], lengths[r]);
+            }
+        }
+        if (!traceWrite(path, merged)) {
+            std::cerr << "Could not write " << path << std::endl;
+        }
+    }
+}
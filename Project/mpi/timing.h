@@ -0,0 +1,94 @@
+/**
+ * @file timing.h
+ * @brief Per-phase timers for the MPI solver.
+ *
+ * This header declares a small timer that accumulates wall-clock time per
+ * solver phase (compute, halo post, halo wait, boundary conditions and I/O)
+ * and a report function that reduces the phase times across all ranks into
+ * min/avg/max statistics and an imbalance ratio. When tracing is compiled in,
+ * every timed interval is also recorded as a trace event named after its phase.
+ */
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <cstdint>
+#include <mpi.h>
+
+/**
+ * @brief Solver phases that are timed separately.
+ */
+enum Phase {
+    PHASE_COMPUTE,   /**< Stencil update of the owned rows */
+    PHASE_HALO_POST, /**< Posting the non-blocking halo sends and receives */
+    PHASE_HALO_WAIT, /**< Waiting for the halo exchange to complete */
+    PHASE_BOUNDARY,  /**< Applying boundary conditions */
+    PHASE_IO,        /**< Output of any kind */
+    NUM_PHASES
+};
+
+/**
+ * @brief Accumulates elapsed time per solver phase on one rank.
+ */
+class PhaseTimer {
+public:
+    PhaseTimer();
+
+    /**
+     * @brief Starts timing a phase.
+     *
+     * @param phase Phase to start.
+     */
+    void start(Phase phase);
+
+    /**
+     * @brief Stops timing a phase and adds the elapsed time to its total.
+     *
+     * @param phase Phase to stop.
+     */
+    void stop(Phase phase);
+
+    /**
+     * @brief Returns the accumulated time of a phase in seconds.
+     *
+     * @param phase Phase to query.
+     */
+    double elapsed(Phase phase) const;
+
+private:
+    double started[NUM_PHASES];
+    double total[NUM_PHASES];
+    int64_t traceStarted[NUM_PHASES];
+};
+
+/**
+ * @brief Returns the printable name of a phase.
+ *
+ * @param phase Phase to name.
+ */
+const char* phaseName(Phase phase);
+
+/**
+ * @brief Reduces the phase times of all ranks and prints a summary on rank 0.
+ *
+ * For each phase the minimum, average and maximum over all ranks are printed
+ * together with the imbalance ratio max/avg. If csvPath is not null, the raw
+ * per-rank times are gathered to rank 0 and written as CSV.
+ *
+ * @param timer Phase times of the calling rank.
+ * @param wallTime Total elapsed time of the calling rank.
+ * @param comm Communicator containing all ranks of the run.
+ * @param csvPath Path of the per-rank CSV file, or nullptr to skip it.
+ */
+void reportPhaseTimes(const PhaseTimer& timer, double wallTime, MPI_Comm comm, const char* csvPath);
+
+/**
+ * @brief Gathers the trace events of all ranks and writes them on rank 0.
+ *
+ * Every rank becomes one process of the trace, with one track per thread.
+ *
+ * @param comm Communicator containing all ranks of the run.
+ * @param path Path of the Chrome trace file.
+ */
+void writeTrace(MPI_Comm comm, const char* path);
+
+#endif // TIMING_H
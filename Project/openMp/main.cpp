@@ -14,102 +14,103 @@
 #include <limits>
 #include <omp.h>
 #include <chrono> // For timing
-
-// Constants
-const int N = 256; // Change grid size to 256
-const double boxsize = 1.0;
-const double c = 1.0;
-const double tEnd = 2.0;
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "checksum.h"
+#include "memory.h"
+#include "metrics.h"
+#include "partition.h"
+#include "probes.h"
+#include "solver.h"
+#include "trace.h"
+#include "video.h"
 
 /**
- * @brief Initializes the grid and boundary conditions.
- * 
- * @param U Vector of vectors representing the grid values.
- * @param mask Vector of vectors representing the grid mask.
- * @param xlin Vector storing the spatial coordinates.
+ * @brief Returns the memory the fields of a grid of n x n cells will take.
+ *
+ * U, Uprev and Unew rotate every step, so the time loop copies no grid.
+ *
+ * @param n Grid size.
  */
-void initializeGrid(std::vector<std::vector<double>>& U, std::vector<std::vector<bool>>& mask, std::vector<double>& xlin) {
-    double dx = boxsize / N;
-    for (int i = 0; i < N; ++i) {
-        xlin[i] = 0.5 * dx + i * dx;
-    }
-
-    for (int i = 0; i < N; ++i) {
-        mask[0][i] = true;
-        mask[N-1][i] = true;
-        mask[i][0] = true;
-        mask[i][N-1] = true;
-    }
-
-    #pragma omp parallel for
-    for (int i = N/4; i < 9*N/32; ++i) {
-        for (int j = 0; j < N-1; ++j) {
-            mask[i][j] = true;
-        }
-    }
-
-    #pragma omp parallel for
-    for (int i = 1; i < N-1; ++i) {
-        for (int j = 5*N/16; j < 3*N/8; ++j) {
-            mask[i][j] = false;
-        }
-        for (int j = 5*N/8; j < 11*N/16; ++j) {
-            mask[i][j] = false;
-        }
-    }
+MemoryReport projectMemory(int n) {
+    MemoryReport report;
+    report.add("U", nestedDoubleBytes(n, n));
+    report.add("Uprev", nestedDoubleBytes(n, n));
+    report.add("Unew", nestedDoubleBytes(n, n));
+    report.add("mask", nestedMaskBytes(n, n));
+    report.add("xlin", flatDoubleBytes(1, n));
+    return report;
 }
 
-/**
- * @brief Calculates the Laplacian of the grid.
- * 
- * @param U Current grid values.
- * @param Unew New grid values after Laplacian calculation.
- * @param mask Grid mask.
- * @param fac Factor used in the numerical approximation.
- */
-void calculateLaplacian(std::vector<std::vector<double>>& U, std::vector<std::vector<double>>& Unew,
-                        const std::vector<std::vector<bool>>& mask, double fac) {
-    std::vector<std::vector<double>> Uprev = U;
-    #pragma omp parallel for collapse(2)
-    for (int i = 1; i < N-1; ++i) {
-        for (int j = 1; j < N-1; ++j) {
-            if (!mask[i][j]) {
-                double ULX = U[i-1][j];
-                double URX = U[i+1][j];
-                double ULY = U[i][j-1];
-                double URY = U[i][j+1];
-                double laplacian = (ULX + URX + ULY + URY - 4.0 * U[i][j]);
-                Unew[i][j] = 2.0 * U[i][j] - Uprev[i][j] + fac * laplacian;
+int main(int argc, char* argv[]) {
+    // Optional arguments: --threads <n>
+    //                     --probes <file> --probe-output <file> --probe-block <steps>
+    //                     --video <file|-> --video-scale <factor> --video-every <steps>
+    //                     --trace <file> --memory <n> --metrics <file> --metrics-every <steps>
+    //                     --checksums <file> --checksum-every <steps>
+    std::vector<int> threads = {1, 32, 64, 128};
+    std::vector<Probe> probeLocations;
+    std::string probeOutput = "probes.bin";
+    int probeBlock = 4096;
+    std::string videoOutput;
+    int videoScale = 1;
+    int videoEvery = 10;
+    std::string traceOutput;
+    int memoryN = 0;
+    std::string metricsOutput;
+    int metricsEvery = 100;
+    std::string checksumOutput;
+    int checksumEvery = 10;
+    for (int a = 1; a < argc - 1; ++a) {
+        if (std::strcmp(argv[a], "--threads") == 0) {
+            threads.assign(1, std::max(1, std::atoi(argv[a + 1])));
+        } else if (std::strcmp(argv[a], "--video") == 0) {
+            videoOutput = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--video-scale") == 0) {
+            videoScale = std::max(1, std::atoi(argv[a + 1]));
+        } else if (std::strcmp(argv[a], "--video-every") == 0) {
+            videoEvery = std::max(1, std::atoi(argv[a + 1]));
+        } else if (std::strcmp(argv[a], "--trace") == 0) {
+            traceOutput = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--memory") == 0) {
+            memoryN = std::atoi(argv[a + 1]);
+        } else if (std::strcmp(argv[a], "--metrics") == 0) {
+            metricsOutput = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--metrics-every") == 0) {
+            metricsEvery = std::max(1, std::atoi(argv[a + 1]));
+        } else if (std::strcmp(argv[a], "--checksums") == 0) {
+            checksumOutput = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--checksum-every") == 0) {
+            checksumEvery = std::max(1, std::atoi(argv[a + 1]));
+        } else if (std::strcmp(argv[a], "--probes") == 0) {
+            if (!readProbes(argv[a + 1], probeLocations)) {
+                std::cerr << "Could not read probes from " << argv[a + 1] << std::endl;
             }
+        } else if (std::strcmp(argv[a], "--probe-output") == 0) {
+            probeOutput = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--probe-block") == 0) {
+            probeBlock = std::max(1, std::atoi(argv[a + 1]));
         }
     }
-}
 
-/**
- * @brief Applies boundary conditions to the grid.
- * 
- * @param U Grid values.
- * @param mask Grid mask.
- * @param t Current time.
- * @param xlin Vector storing the spatial coordinates.
- */
-void applyBoundaryConditions(std::vector<std::vector<double>>& U, const std::vector<std::vector<bool>>& mask, double t,
-                             const std::vector<double>& xlin) {
-    for (int i = 0; i < N; ++i) {
-        if (mask[i][0] || mask[i][N-1] || mask[0][i] || mask[N-1][i]) {
-            U[i][0] = U[i][N-1] = U[0][i] = U[N-1][i] = 0.0;
-        }
-    }
+    // With the video on stdout the log goes to stderr
+    std::ostream& log = videoOutput == "-" ? std::cerr : std::cout;
 
-    #pragma omp parallel for
-    for (int i = 0; i < N; ++i) {
-        U[0][i] = std::sin(20.0 * M_PI * t) * std::pow(std::sin(M_PI * xlin[i]), 2);
+    // Project the memory before allocating; for any other n than N stop there
+    if (memoryN > 0) {
+        projectMemory(memoryN).print(log, "Projected memory for N = " + std::to_string(memoryN),
+                                     static_cast<size_t>(memoryN) * memoryN);
+        if (memoryN != N) {
+            return 0;
+        }
     }
-}
 
-int main() {
     std::vector<double> xlin(N);
     std::vector<std::vector<double>> U(N, std::vector<double>(N, 0.0));
+    std::vector<std::vector<double>> Uprev(N, std::vector<double>(N, 0.0));
+    std::vector<std::vector<double>> Unew(N, std::vector<double>(N, 0.0));
     std::vector<std::vector<bool>> mask(N, std::vector<bool>(N, false));
 
     initializeGrid(U, mask, xlin);
@@ -124,21 +125,98 @@ int main() {
     std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
     double duration;
 
-    // Array of thread counts
-    int threads[] = {1, 32, 64, 128};
+    // Frames are streamed from the first run only
+    VideoWriter video(N, videoScale, 30);
+    if (!videoOutput.empty()) {
+        video.open(videoOutput);
+    }
+
+    // Every thread count restarts the step count in the same metrics file
+    MetricsWriter metrics;
+    if (!metricsOutput.empty() && !metrics.open(metricsOutput, 0, 1, tEnd)) {
+        std::cerr << "Could not open " << metricsOutput << std::endl;
+    }
 
     // Run the program with different numbers of threads
-    for (int i = 0; i < sizeof(threads) / sizeof(threads[0]); ++i) {
+    for (size_t i = 0; i < threads.size(); ++i) {
         omp_set_num_threads(threads[i]);
 
+        // Every thread count starts from the initial field
+        for (int row = 0; row < N; ++row) {
+            std::fill(U[row].begin(), U[row].end(), 0.0);
+            std::fill(Uprev[row].begin(), Uprev[row].end(), 0.0);
+            std::fill(Unew[row].begin(), Unew[row].end(), 0.0);
+        }
+
+        // Bands of rows with equal active cells, fixed for the whole run
+        std::vector<int> bounds = balancedRowPartition(mask, threads[i]);
+        double imbalance = partitionImbalance(partitionWork(mask, bounds));
+
+        // One probe file per thread count, e.g. probes.bin.32
+        ProbeRecorder probes(probeLocations, N, boxsize, dt, 0, N - 1, probeBlock);
+        if (probes.size() > 0) {
+            probes.open(probeOutput + "." + std::to_string(threads[i]));
+        }
+
         // Start timing
         start = std::chrono::high_resolution_clock::now();
+        auto metricsSample = [&](int steps) {
+            MetricsSample sample;
+            sample.step = steps;
+            sample.time = t;
+            sample.stepRate = 0.0;
+            sample.energy = 0.0;
+            for (int row = 0; row < N; ++row) {
+                for (int col = 0; col < N; ++col) {
+                    sample.energy += U[row][col] * U[row][col];
+                }
+            }
+            sample.computeSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+            sample.waitSeconds = 0.0;
+            sample.imbalance = imbalance;
+            return sample;
+        };
+
+        // One checksum file per thread count as well
+        std::vector<FieldChecksum> checksums;
+        if (!checksumOutput.empty()) {
+            checksums.push_back(fieldChecksum(U, 0));
+        }
 
         // Main loop
+        int step = 0;
         while (t < tEnd) {
-            calculateLaplacian(U, U, mask, fac);
+            sampleProbes(probes, U);
+            calculateLaplacian(U, Uprev, Unew, mask, fac, bounds);
+            rotateGrids(U, Uprev, Unew);
             applyBoundaryConditions(U, mask, t, xlin);
             t += dt;
+
+            if (video.isOpen() && step % videoEvery == 0) {
+                TRACE_SCOPE("output");
+                video.addFrame(U, mask);
+            }
+            ++step;
+
+            if (metrics.isOpen() && step % metricsEvery == 0) {
+                TRACE_SCOPE("output");
+                metrics.publish(metricsSample(step));
+            }
+
+            if (!checksumOutput.empty() && (step % checksumEvery == 0 || t >= tEnd)) {
+                TRACE_SCOPE("output");
+                checksums.push_back(fieldChecksum(U, step));
+            }
+        }
+
+        probes.flush();
+        video.close();
+        std::string checksumFile = checksumOutput + "." + std::to_string(threads[i]);
+        if (!checksumOutput.empty() && !writeChecksums(checksumFile, checksums)) {
+            std::cerr << "Could not write " << checksumFile << std::endl;
+        }
+        if (i + 1 == threads.size()) {
+            metrics.finish(metricsSample(step));
         }
 
         // End timing
@@ -146,12 +224,32 @@ int main() {
         duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1e6;
 
         // Output execution time
-        std::cout << "Threads: " << threads[i] << ", Execution time: " << duration << " seconds\n";
+        log << "Threads: " << threads[i] << ", Execution time: " << duration << " seconds"
+            << ", Partition imbalance: " << imbalance << "\n";
 
         // Reset time for next iteration
         t = 0.0;
     }
 
+    if (memoryN > 0) {
+        MemoryReport report;
+        report.add("U", bytesOf(U));
+        report.add("Uprev", bytesOf(Uprev));
+        report.add("Unew", bytesOf(Unew));
+        report.add("mask", bytesOf(mask));
+        report.add("xlin", bytesOf(xlin));
+        report.print(log, "Allocated memory", static_cast<size_t>(N) * N);
+        printResidentMemory(log);
+    }
+
+    if (!traceOutput.empty()) {
+        if (!traceEnabled) {
+            std::cerr << "Tracing is not compiled in, rebuild with make TRACE=1" << std::endl;
+        } else if (!traceWrite(traceOutput, traceEvents(0, "openMp"))) {
+            std::cerr << "Could not write " << traceOutput << std::endl;
+        }
+    }
+
     return 0;
 }
 
@@ -0,0 +1,111 @@
+/**
+ * @file solver.cpp
+ * @brief Implementation of the OpenMP kernels declared in solver.h.
+ */
+
+#include "solver.h"
+#include <cmath>
+#include <omp.h>
+#include "trace.h"
+
+const int N = 256; // Change grid size to 256
+const double boxsize = 1.0;
+const double c = 1.0;
+const double tEnd = 2.0;
+
+void initializeGrid(std::vector<std::vector<double>>& U, std::vector<std::vector<bool>>& mask, std::vector<double>& xlin) {
+    double dx = boxsize / N;
+    for (int i = 0; i < N; ++i) {
+        xlin[i] = 0.5 * dx + i * dx;
+    }
+
+    for (int i = 0; i < N; ++i) {
+        mask[0][i] = true;
+        mask[N-1][i] = true;
+        mask[i][0] = true;
+        mask[i][N-1] = true;
+    }
+
+    #pragma omp parallel for
+    for (int i = N/4; i < 9*N/32; ++i) {
+        for (int j = 0; j < N-1; ++j) {
+            mask[i][j] = true;
+        }
+    }
+
+    #pragma omp parallel for
+    for (int i = 1; i < N-1; ++i) {
+        for (int j = 5*N/16; j < 3*N/8; ++j) {
+            mask[i][j] = false;
+        }
+        for (int j = 5*N/8; j < 11*N/16; ++j) {
+            mask[i][j] = false;
+        }
+    }
+}
+
+void calculateLaplacian(const std::vector<std::vector<double>>& U, const std::vector<std::vector<double>>& Uprev,
+                        std::vector<std::vector<double>>& Unew, const std::vector<std::vector<bool>>& mask, double fac,
+                        const std::vector<int>& bounds) {
+    int parts = static_cast<int>(bounds.size()) - 1;
+    #pragma omp parallel num_threads(parts)
+    {
+        {
+            TRACE_SCOPE("compute");
+            // normally one band per thread, unless the runtime granted fewer threads
+            for (int band = omp_get_thread_num(); band < parts; band += omp_get_num_threads()) {
+                for (int i = bounds[band]; i < bounds[band + 1]; ++i) {
+                    for (int j = 1; j < N-1; ++j) {
+                        if (!mask[i][j]) {
+                            double ULX = U[i-1][j];
+                            double URX = U[i+1][j];
+                            double ULY = U[i][j-1];
+                            double URY = U[i][j+1];
+                            double laplacian = (ULX + URX + ULY + URY - 4.0 * U[i][j]);
+                            Unew[i][j] = 2.0 * U[i][j] - Uprev[i][j] + fac * laplacian;
+                        }
+                    }
+                }
+            }
+        }
+
+        // the wait for the slowest thread shows up as its own event
+        TRACE_SCOPE("barrier");
+        #pragma omp barrier
+    }
+}
+
+void rotateGrids(std::vector<std::vector<double>>& U, std::vector<std::vector<double>>& Uprev,
+                 std::vector<std::vector<double>>& Unew) {
+    Uprev.swap(U);
+    U.swap(Unew);
+}
+
+void applyBoundaryConditions(std::vector<std::vector<double>>& U, const std::vector<std::vector<bool>>& mask, double t,
+                             const std::vector<double>& xlin) {
+    TRACE_SCOPE("boundary");
+    for (int i = 0; i < N; ++i) {
+        if (mask[i][0] || mask[i][N-1] || mask[0][i] || mask[N-1][i]) {
+            U[i][0] = U[i][N-1] = U[0][i] = U[N-1][i] = 0.0;
+        }
+    }
+
+    #pragma omp parallel for
+    for (int i = 0; i < N; ++i) {
+        U[0][i] = std::sin(20.0 * M_PI * t) * std::pow(std::sin(M_PI * xlin[i]), 2);
+    }
+}
+
+void sampleProbes(ProbeRecorder& probes, const std::vector<std::vector<double>>& U) {
+    // Without probes there is nothing to record, so skip the fork and join
+    if (probes.empty()) {
+        return;
+    }
+    TRACE_SCOPE("output");
+    auto field = [&](int i, int j) { return U[i][j]; };
+    #pragma omp parallel for schedule(static)
+    for (int p = 0; p < probes.size(); ++p) {
+        probes.sample(p, field);
+    }
+    probes.endStep();
+}
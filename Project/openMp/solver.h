@@ -0,0 +1,81 @@
+/**
+ * @file solver.h
+ * @brief Kernels of the OpenMP solver.
+ *
+ * The grid is stored as a vector of rows. Every kernel works on buffers
+ * allocated by the caller, so the time loop itself does not allocate.
+ */
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <vector>
+#include "probes.h"
+
+// Constants
+extern const int N;
+extern const double boxsize;
+extern const double c;
+extern const double tEnd;
+
+/**
+ * @brief Initializes the grid and boundary conditions.
+ * 
+ * @param U Vector of vectors representing the grid values.
+ * @param mask Vector of vectors representing the grid mask.
+ * @param xlin Vector storing the spatial coordinates.
+ */
+void initializeGrid(std::vector<std::vector<double>>& U, std::vector<std::vector<bool>>& mask, std::vector<double>& xlin);
+
+/**
+ * @brief Calculates the Laplacian of the grid.
+ *
+ * Every thread updates one contiguous band of rows with about the same number
+ * of active cells, so threads with wall-heavy bands do not wait for the others.
+ * The caller rotates the three grids afterwards (see rotateGrids()).
+ *
+ * @param U Current grid values.
+ * @param Uprev Grid values one step earlier.
+ * @param Unew New grid values after Laplacian calculation; may not alias U or Uprev.
+ * @param mask Grid mask.
+ * @param fac Factor used in the numerical approximation.
+ * @param bounds Row boundaries of the bands, one band per thread.
+ */
+void calculateLaplacian(const std::vector<std::vector<double>>& U, const std::vector<std::vector<double>>& Uprev,
+                        std::vector<std::vector<double>>& Unew, const std::vector<std::vector<bool>>& mask, double fac,
+                        const std::vector<int>& bounds);
+
+/**
+ * @brief Makes Unew the current grid and U the previous one.
+ *
+ * The grids are swapped, not copied; Unew receives the oldest grid as scratch.
+ *
+ * @param U Current grid values.
+ * @param Uprev Grid values one step earlier.
+ * @param Unew New grid values.
+ */
+void rotateGrids(std::vector<std::vector<double>>& U, std::vector<std::vector<double>>& Uprev,
+                 std::vector<std::vector<double>>& Unew);
+
+/**
+ * @brief Applies boundary conditions to the grid.
+ * 
+ * @param U Grid values.
+ * @param mask Grid mask.
+ * @param t Current time.
+ * @param xlin Vector storing the spatial coordinates.
+ */
+void applyBoundaryConditions(std::vector<std::vector<double>>& U, const std::vector<std::vector<bool>>& mask, double t,
+                             const std::vector<double>& xlin);
+
+/**
+ * @brief Records the current value of all probes.
+ *
+ * The probes are split statically over the threads, so every thread fills its
+ * own contiguous part of the probe buffers.
+ *
+ * @param probes Probe recorder.
+ * @param U Grid values.
+ */
+void sampleProbes(ProbeRecorder& probes, const std::vector<std::vector<double>>& U);
+
+#endif // SOLVER_H
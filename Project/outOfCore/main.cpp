@@ -0,0 +1,104 @@
+/**
+ * @file main.cpp
+ * @brief Runs the double slit with the fields on disk, for grids larger than memory.
+ *
+ * The band size follows from a memory budget for the resident window, so the
+ * same command runs any grid size in bounded memory. The fields take four
+ * files of N x N doubles in the directory given by --dir, which should be
+ * on a local disk with room for them.
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "checksum.h"
+#include "memory.h"
+#include "out_of_core.h"
+
+int main(int argc, char* argv[]) {
+    // Optional arguments: --N <n> --tEnd <t> --dir <directory> --window-mb <megabytes>
+    //                     --band-rows <rows> --steps-per-pass <steps>
+    //                     --checksums <file> --checksum-every <steps>
+    SimulationConfig config = defaultConfig();
+    std::string directory = ".";
+    double windowMegabytes = 256.0;
+    int bandRows = 0;
+    int stepsPerPass = 8;
+    std::string checksumOutput;
+    int checksumEvery = 10;
+    for (int a = 1; a < argc; ++a) {
+        bool hasValue = a + 1 < argc;
+        if (hasValue && std::strcmp(argv[a], "--N") == 0) {
+            config.N = std::atoi(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--tEnd") == 0) {
+            config.tEnd = std::atof(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--dir") == 0) {
+            directory = argv[++a];
+        } else if (hasValue && std::strcmp(argv[a], "--window-mb") == 0) {
+            windowMegabytes = std::atof(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--band-rows") == 0) {
+            bandRows = std::atoi(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--steps-per-pass") == 0) {
+            stepsPerPass = std::max(1, std::atoi(argv[++a]));
+        } else if (hasValue && std::strcmp(argv[a], "--checksums") == 0) {
+            checksumOutput = argv[++a];
+        } else if (hasValue && std::strcmp(argv[a], "--checksum-every") == 0) {
+            checksumEvery = std::max(1, std::atoi(argv[++a]));
+        }
+    }
+    const int n = config.N;
+
+    // The window holds three fields of bandRows + 2 stepsPerPass rows
+    if (bandRows <= 0) {
+        double rowBytes = 3.0 * n * sizeof(double);
+        bandRows = static_cast<int>(windowMegabytes * 1024 * 1024 / rowBytes) - 2 * stepsPerPass;
+        bandRows = std::min(bandRows, n);
+        if (bandRows < 1) {
+            std::cerr << "A window of " << windowMegabytes << " MB holds fewer than " << 2 * stepsPerPass + 1
+                      << " rows of N = " << n << "; raise --window-mb or lower --steps-per-pass" << std::endl;
+            return 1;
+        }
+    }
+
+    OutOfCoreGrid grid;
+    if (!initializeOutOfCore(grid, config, directory, bandRows, stepsPerPass)) {
+        std::cerr << "Could not create the field files in " << directory << std::endl;
+        return 1;
+    }
+
+    MemoryReport report;
+    report.add("window U", bytesOf(grid.windowU));
+    report.add("window Uprev", bytesOf(grid.windowUprev));
+    report.add("window Unew", bytesOf(grid.windowUnew));
+    report.add("mask", bytesOf(grid.mask));
+    report.add("xlin", bytesOf(grid.xlin));
+    report.print(std::cout, "Resident memory", static_cast<size_t>(n) * n);
+    double fileGigabytes = 4.0 * grid.U[0].bytes() / (1024.0 * 1024 * 1024);
+    std::printf("Fields on disk: %.2f GB in %s (node memory %.2f GB)\n", fileGigabytes, directory.c_str(),
+                nodeMemoryBytes() / (1024.0 * 1024 * 1024));
+    std::printf("Bands of %d rows, %d steps per pass\n", grid.bandRows, grid.stepsPerPass);
+
+    std::vector<FieldChecksum> checksums;
+    auto start = std::chrono::high_resolution_clock::now();
+    FieldChecksum result = runOutOfCore(grid, checksumOutput.empty() ? nullptr : &checksums, checksumEvery);
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    // Updates beyond one per interior cell and step are the recomputed halos
+    double useful = static_cast<double>(grid.step) * (n - 2) * (n - 2);
+    std::printf("Steps: %ld in %ld passes, %.3f ms per step, %.1f%% of the updates recomputed halos\n",
+                grid.step, grid.passes, grid.step > 0 ? 1e3 * seconds / grid.step : 0.0,
+                grid.cellUpdates > 0 ? 100.0 * (1.0 - useful / grid.cellUpdates) : 0.0);
+    std::printf("Final energy: %.6f\n", result.energy);
+    printResidentMemory(std::cout);
+
+    if (!checksumOutput.empty() && !writeChecksums(checksumOutput, checksums)) {
+        std::cerr << "Could not write " << checksumOutput << std::endl;
+        return 1;
+    }
+    return 0;
+}
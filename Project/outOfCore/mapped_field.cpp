@@ -0,0 +1,94 @@
+/**
+ * @file mapped_field.cpp
+ * @brief Implementation of the MappedField class declared in mapped_field.h.
+ */
+
+#include "mapped_field.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+MappedField::MappedField() : data(nullptr), rows(0), cols(0) {}
+
+MappedField::~MappedField() {
+    if (data != nullptr) {
+        munmap(data, bytes());
+    }
+}
+
+bool MappedField::open(const std::string& path, int rows, int cols) {
+    if (data != nullptr) {
+        munmap(data, bytes());
+        data = nullptr;
+    }
+    this->rows = rows;
+    this->cols = cols;
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    // ftruncate() extends the file with zeros without writing them, so a fresh
+    // field costs no disk traffic
+    void* mapping = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(bytes())) == 0) {
+        mapping = mmap(nullptr, bytes(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    // The solver sweeps the rows in order; this doubles the kernel's read-ahead
+    madvise(mapping, bytes(), MADV_SEQUENTIAL);
+    data = static_cast<double*>(mapping);
+    return true;
+}
+
+bool MappedField::isOpen() const {
+    return data != nullptr;
+}
+
+double* MappedField::row(int i) {
+    return data + static_cast<size_t>(i) * cols;
+}
+
+const double* MappedField::row(int i) const {
+    return data + static_cast<size_t>(i) * cols;
+}
+
+size_t MappedField::bytes() const {
+    return static_cast<size_t>(rows) * cols * sizeof(double);
+}
+
+bool MappedField::pageRange(int first, int last, char*& start, size_t& length) const {
+    if (data == nullptr || first < 0 || last > rows || first >= last) {
+        return false;
+    }
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t begin = static_cast<size_t>(first) * cols * sizeof(double) / page * page;
+    size_t end = static_cast<size_t>(last) * cols * sizeof(double);
+    start = reinterpret_cast<char*>(data) + begin;
+    length = end - begin;
+    return true;
+}
+
+void MappedField::prefetch(int first, int last) const {
+    char* start;
+    size_t length;
+    if (pageRange(first, last, start, length)) {
+        madvise(start, length, MADV_WILLNEED);
+    }
+}
+
+void MappedField::release(int first, int last) {
+    char* start;
+    size_t length;
+    if (pageRange(first, last, start, length)) {
+        // Pages shared with a neighbouring row are dropped as well; they are
+        // written back like the others and read again if needed
+        msync(start, length, MS_ASYNC);
+        madvise(start, length, MADV_DONTNEED);
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file mapped_field.h
+ * @brief A field of doubles that lives in a memory-mapped file.
+ *
+ * The kernel pages rows in on access and writes dirty rows back on its own,
+ * so the field may be much larger than the memory of the node. Since the
+ * solver knows which rows it needs next, it announces them with prefetch()
+ * and hands back the rows it is done with with release(), instead of leaving
+ * both to the page replacement.
+ */
+#ifndef MAPPED_FIELD_H
+#define MAPPED_FIELD_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief rows x cols doubles in a file, row by row.
+ */
+class MappedField {
+public:
+    MappedField();
+
+    /**
+     * @brief Unmaps the file; its contents stay in the file.
+     */
+    ~MappedField();
+
+    MappedField(const MappedField&) = delete;
+    MappedField& operator=(const MappedField&) = delete;
+
+    /**
+     * @brief Creates a file of zeros and maps it.
+     *
+     * @param path File to create or overwrite; it may be removed once mapped.
+     * @param rows Number of rows.
+     * @param cols Number of doubles per row.
+     * @return false if the file could not be created or mapped.
+     */
+    bool open(const std::string& path, int rows, int cols);
+
+    /**
+     * @brief Returns whether a file is mapped.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Returns row i.
+     */
+    double* row(int i);
+    const double* row(int i) const;
+
+    /**
+     * @brief Starts reading rows [first, last) from disk in the background.
+     */
+    void prefetch(int first, int last) const;
+
+    /**
+     * @brief Drops rows [first, last) from the memory of the process.
+     *
+     * Modified rows are scheduled for writing back and stay in the page cache
+     * until the kernel evicts them, so their contents are kept; the next
+     * access maps them again, from the file if they were evicted.
+     */
+    void release(int first, int last);
+
+    /**
+     * @brief Returns the size of the file in bytes.
+     */
+    size_t bytes() const;
+
+private:
+    /**
+     * @brief Returns the page-aligned range of bytes that covers rows [first, last).
+     */
+    bool pageRange(int first, int last, char*& start, size_t& length) const;
+
+    double* data;
+    int rows;
+    int cols;
+};
+
+#endif // MAPPED_FIELD_H
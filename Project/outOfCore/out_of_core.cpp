@@ -0,0 +1,201 @@
+/**
+ * @file out_of_core.cpp
+ * @brief Implementation of the out-of-core solver declared in out_of_core.h.
+ */
+
+#include "out_of_core.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unistd.h>
+
+bool initializeOutOfCore(OutOfCoreGrid& grid, const SimulationConfig& config, const std::string& directory,
+                         int bandRows, int stepsPerPass) {
+    const int n = config.N;
+    grid.config = config;
+    grid.xlin.assign(n, 0.0);
+    grid.mask.assign(n, std::vector<bool>(n, false));
+
+    // initializeGrid() only sets the mask and coordinates
+    std::vector<std::vector<double>> unused;
+    initializeGrid(unused, grid.mask, grid.xlin, config);
+
+    // e.g. ./outOfCore.1234.U0; a fresh file holds the zero initial field
+    const std::string prefix = directory + "/outOfCore." + std::to_string(getpid()) + ".";
+    for (int g = 0; g < 2; ++g) {
+        const std::string uPath = prefix + "U" + std::to_string(g);
+        const std::string uprevPath = prefix + "Uprev" + std::to_string(g);
+        bool opened = grid.U[g].open(uPath, n, n) && grid.Uprev[g].open(uprevPath, n, n);
+        unlink(uPath.c_str());
+        unlink(uprevPath.c_str());
+        if (!opened) {
+            return false;
+        }
+    }
+    grid.current = 0;
+
+    grid.bandRows = std::max(1, bandRows);
+    grid.stepsPerPass = std::max(1, stepsPerPass);
+    const int windowRows = std::min(n, grid.bandRows + 2 * grid.stepsPerPass);
+    grid.windowU.assign(windowRows, std::vector<double>(n, 0.0));
+    grid.windowUprev.assign(windowRows, std::vector<double>(n, 0.0));
+    grid.windowUnew.assign(windowRows, std::vector<double>(n, 0.0));
+
+    double dx = config.boxsize / n;
+    grid.dt = (std::sqrt(2)/2) * dx / config.c;
+    grid.fac = grid.dt*grid.dt * config.c*config.c / (dx*dx);
+    grid.t = 0.0;
+    grid.step = 0;
+    grid.passes = 0;
+    grid.cellUpdates = 0;
+    return true;
+}
+
+/**
+ * @brief One leapfrog step of global rows [first, last) in a window starting at global row w0.
+ */
+static void updateWindowRows(OutOfCoreGrid& grid, int w0, int first, int last) {
+    const int n = grid.config.N;
+    const double fac = grid.fac;
+    for (int i = first; i < last; ++i) {
+        const std::vector<double>& above = grid.windowU[i - 1 - w0];
+        const std::vector<double>& centre = grid.windowU[i - w0];
+        const std::vector<double>& below = grid.windowU[i + 1 - w0];
+        const std::vector<double>& prev = grid.windowUprev[i - w0];
+        std::vector<double>& next = grid.windowUnew[i - w0];
+        const std::vector<bool>& mask = grid.mask[i];
+        for (int j = 1; j < n-1; ++j) {
+            if (!mask[j]) {
+                double laplacian = (above[j] + below[j] + centre[j-1] + centre[j+1] - 4.0 * centre[j]);
+                next[j] = 2.0 * centre[j] - prev[j] + fac * laplacian;
+            }
+        }
+    }
+    grid.cellUpdates += static_cast<long>(last - first) * (n - 2);
+}
+
+void runPass(OutOfCoreGrid& grid, int steps, FieldChecksum* checksum) {
+    const int n = grid.config.N;
+    const int bandRows = grid.bandRows;
+    steps = std::max(1, std::min(steps, grid.stepsPerPass));
+    MappedField& U = grid.U[grid.current];
+    MappedField& Uprev = grid.Uprev[grid.current];
+    MappedField& nextU = grid.U[1 - grid.current];
+    MappedField& nextUprev = grid.Uprev[1 - grid.current];
+    if (checksum != nullptr) {
+        *checksum = emptyChecksum(grid.step + steps);
+    }
+
+    const double t0 = grid.t;
+    double t = t0;
+    for (int b0 = 0; b0 < n; b0 += bandRows) {
+        const int b1 = std::min(n, b0 + bandRows);
+        const int w0 = std::max(0, b0 - steps);
+        const int w1 = std::min(n, b1 + steps);
+
+        // The kernel reads the rows the next window adds while this band computes
+        if (b1 < n) {
+            const int nextEnd = std::min(n, b1 + bandRows + steps);
+            U.prefetch(w1, nextEnd);
+            Uprev.prefetch(w1, nextEnd);
+        }
+
+        // Window rows are reused by every band: the old generation is loaded,
+        // and Unew starts from zero so the masked cells, which are never
+        // written, hold zero as in the reference
+        for (int i = w0; i < w1; ++i) {
+            std::memcpy(grid.windowU[i - w0].data(), U.row(i), n * sizeof(double));
+            std::memcpy(grid.windowUprev[i - w0].data(), Uprev.row(i), n * sizeof(double));
+            std::fill(grid.windowUnew[i - w0].begin(), grid.windowUnew[i - w0].end(), 0.0);
+        }
+
+        // Every step invalidates one more row at each inner edge of the
+        // window; the domain edges are boundary rows and stay valid
+        t = t0;
+        for (int k = 1; k <= steps; ++k) {
+            const int first = w0 == 0 ? 1 : w0 + k;
+            const int last = w1 == n ? n - 1 : w1 - k;
+            updateWindowRows(grid, w0, first, last);
+
+            grid.windowUprev.swap(grid.windowU);
+            grid.windowU.swap(grid.windowUnew);
+
+            // The walls are masked cells and stay zero; only the inflow row is set
+            if (w0 == 0) {
+                std::vector<double>& inflow = grid.windowU[0];
+                for (int j = 0; j < n; ++j) {
+                    inflow[j] = std::sin(2.0 * grid.config.frequency * M_PI * t) * std::pow(std::sin(M_PI * grid.xlin[j]), 2);
+                }
+            }
+            t += grid.dt;
+        }
+
+        // The neighbours of later bands still need the old rows, so the band
+        // goes to the other generation
+        for (int i = b0; i < b1; ++i) {
+            std::memcpy(nextU.row(i), grid.windowU[i - w0].data(), n * sizeof(double));
+            std::memcpy(nextUprev.row(i), grid.windowUprev[i - w0].data(), n * sizeof(double));
+            if (checksum != nullptr) {
+                addRow(*checksum, i, grid.windowU[i - w0].data(), n);
+            }
+        }
+
+        // Windows only move down, so the old rows above the next window are done
+        const int nextW0 = b1 < n ? std::max(0, b1 - steps) : n;
+        U.release(w0, nextW0);
+        Uprev.release(w0, nextW0);
+        nextU.release(b0, b1);
+        nextUprev.release(b0, b1);
+    }
+
+    grid.t = t;
+    grid.step += steps;
+    ++grid.passes;
+    grid.current = 1 - grid.current;
+}
+
+long stepsToEnd(const SimulationConfig& config, double dt) {
+    // The same accumulation of t as the reference loop
+    double t = 0.0;
+    long steps = 0;
+    while (t < config.tEnd) {
+        t += dt;
+        ++steps;
+    }
+    return steps;
+}
+
+FieldChecksum runOutOfCore(OutOfCoreGrid& grid, std::vector<FieldChecksum>* checksums, int checksumEvery) {
+    const int n = grid.config.N;
+    const long total = stepsToEnd(grid.config, grid.dt);
+    checksumEvery = std::max(1, checksumEvery);
+
+    // The initial field is zero
+    FieldChecksum last = emptyChecksum(grid.step);
+    const std::vector<double> zeros(n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        addRow(last, i, zeros.data(), n);
+    }
+    if (checksums != nullptr) {
+        checksums->push_back(last);
+    }
+
+    while (grid.step < total) {
+        long steps = std::min<long>(grid.stepsPerPass, total - grid.step);
+        if (checksums != nullptr) {
+            steps = std::min<long>(steps, checksumEvery - grid.step % checksumEvery);
+        }
+        const long end = grid.step + steps;
+        const bool record = end == total || (checksums != nullptr && end % checksumEvery == 0);
+        runPass(grid, static_cast<int>(steps), record ? &last : nullptr);
+        if (checksums != nullptr && record) {
+            checksums->push_back(last);
+        }
+    }
+    return last;
+}
+
+size_t windowBytes(int n, int bandRows, int stepsPerPass) {
+    size_t rows = std::min<size_t>(n, static_cast<size_t>(bandRows) + 2 * static_cast<size_t>(stepsPerPass));
+    return 3 * rows * n * sizeof(double);
+}
@@ -0,0 +1,101 @@
+/**
+ * @file out_of_core.h
+ * @brief Leapfrog wave solver whose fields live on disk.
+ *
+ * U and Uprev are memory-mapped files, and only a band of rows is resident at
+ * a time. A pass over the bands advances the whole field by several steps:
+ * each band is loaded together with one halo row per step on each side,
+ * stepped in memory while the valid rows shrink by one per step, and its own
+ * rows are written to a second pair of files, since the bands after it still
+ * need the old values. Disk traffic is thus spread over all steps of a pass,
+ * at the cost of recomputing the halo rows. While a band is computed the next
+ * one is prefetched, and the rows already used are released.
+ *
+ * The arithmetic is that of the reference in unitTests/simulation.h,
+ * operation for operation, so the results agree bit for bit.
+ */
+#ifndef OUT_OF_CORE_H
+#define OUT_OF_CORE_H
+
+#include <string>
+#include <vector>
+#include "checksum.h"
+#include "mapped_field.h"
+#include "simulation.h"
+
+/**
+ * @brief State of an out-of-core simulation.
+ */
+struct OutOfCoreGrid {
+    SimulationConfig config;
+    std::vector<double> xlin;
+    std::vector<std::vector<bool>> mask;
+    MappedField U[2];                          /**< Field at the current time, by generation */
+    MappedField Uprev[2];                      /**< Field one step earlier, by generation */
+    int current;                               /**< Generation that holds the current fields */
+    std::vector<std::vector<double>> windowU;  /**< Resident rows of a band and its halos */
+    std::vector<std::vector<double>> windowUprev;
+    std::vector<std::vector<double>> windowUnew;
+    int bandRows;                              /**< Rows written by each band */
+    int stepsPerPass;                          /**< Time steps per pass over the bands */
+    double dt;
+    double fac;
+    double t;
+    long step;
+    long passes;
+    long cellUpdates;                          /**< Cell updates done, including the recomputed halos */
+};
+
+/**
+ * @brief Creates the field files and the resident window.
+ *
+ * The files are removed as soon as they are mapped, so nothing is left on
+ * disk when the run ends or is killed.
+ *
+ * @param grid Grid to initialize.
+ * @param config Simulation parameters.
+ * @param directory Directory for the four field files.
+ * @param bandRows Rows written by each band, at least 1.
+ * @param stepsPerPass Time steps per pass over the bands, at least 1.
+ * @return false if a file could not be created.
+ */
+bool initializeOutOfCore(OutOfCoreGrid& grid, const SimulationConfig& config, const std::string& directory,
+                         int bandRows, int stepsPerPass);
+
+/**
+ * @brief Advances all bands by up to stepsPerPass steps.
+ *
+ * @param grid Initialized grid.
+ * @param steps Number of steps, at most grid.stepsPerPass.
+ * @param checksum Receives the checksum of the field after the pass, or nullptr.
+ */
+void runPass(OutOfCoreGrid& grid, int steps, FieldChecksum* checksum = nullptr);
+
+/**
+ * @brief Steps the simulation from t = 0 until config.tEnd.
+ *
+ * @param grid Initialized grid.
+ * @param checksums Receives a checksum of the field at step 0, every
+ *                  checksumEvery steps and at the end, or nullptr; passes are
+ *                  cut short where needed to reach these steps.
+ * @param checksumEvery Number of steps between checksums.
+ * @return Checksum of the final field, whose energy is the sum of U^2.
+ */
+FieldChecksum runOutOfCore(OutOfCoreGrid& grid, std::vector<FieldChecksum>* checksums = nullptr,
+                           int checksumEvery = 10);
+
+/**
+ * @brief Returns the number of steps the reference takes to reach config.tEnd.
+ */
+long stepsToEnd(const SimulationConfig& config, double dt);
+
+/**
+ * @brief Returns the resident bytes of the window for a band size.
+ *
+ * @param n Grid size.
+ * @param bandRows Rows written by each band.
+ * @param stepsPerPass Time steps per pass, which set the halo rows.
+ */
+size_t windowBytes(int n, int bandRows, int stepsPerPass);
+
+#endif // OUT_OF_CORE_H
@@ -0,0 +1,106 @@
+/**
+ * @file main.cpp
+ * @brief Runs the double slit with the C++17 parallel-algorithms backend.
+ *
+ * The same configuration is also run with the serial solver of
+ * unitTests/simulation.cpp unless --no-serial is given, and the two
+ * screens and field energies are compared. The number of TBB worker threads
+ * follows the machine; restrict it with taskset or the TBB environment.
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "checksum.h"
+#include "parallel_simulation.h"
+#include "simulation.h"
+
+/**
+ * @brief Runs one backend until tEnd and reports its time.
+ *
+ * @param name Name printed with the timing.
+ * @param sim Initialized simulation.
+ * @param step Time step function of the backend.
+ * @param energy Field energy function of the backend.
+ * @param checksums Receives field checksums every checksumEvery steps, or nullptr.
+ * @param checksumEvery Number of steps between checksums.
+ * @return Execution time in seconds.
+ */
+static double runBackend(const char* name, Simulation& sim, void (*step)(Simulation&), double (*energy)(const Simulation&),
+                         std::vector<FieldChecksum>* checksums, int checksumEvery) {
+    auto start = std::chrono::high_resolution_clock::now();
+    long steps = 0;
+    if (checksums != nullptr) {
+        checksums->push_back(fieldChecksum(fullField(sim), steps));
+    }
+    while (sim.t < sim.config.tEnd) {
+        step(sim);
+        ++steps;
+        if (checksums != nullptr && (steps % checksumEvery == 0 || sim.t >= sim.config.tEnd)) {
+            checksums->push_back(fieldChecksum(fullField(sim), steps));
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double duration = std::chrono::duration<double>(end - start).count();
+
+    double cells = static_cast<double>(sim.U.size()) * sim.U[0].size() * steps;
+    std::cout << "Backend: " << name << ", Execution time: " << duration << " seconds"
+              << ", Cell updates per second: " << (duration > 0.0 ? cells / duration : 0.0)
+              << ", Field energy: " << energy(sim) << std::endl;
+    return duration;
+}
+
+int main(int argc, char* argv[]) {
+    // Optional arguments: --N <n> --tEnd <t> --no-symmetry --no-serial
+    //                     --checksums <file> --checksum-every <steps>
+    SimulationConfig config = defaultConfig();
+    bool useSymmetry = true;
+    bool serial = true;
+    std::string checksumOutput;
+    int checksumEvery = 10;
+    for (int a = 1; a < argc; ++a) {
+        bool hasValue = a + 1 < argc;
+        if (std::strcmp(argv[a], "--no-symmetry") == 0) {
+            useSymmetry = false;
+        } else if (std::strcmp(argv[a], "--no-serial") == 0) {
+            serial = false;
+        } else if (hasValue && std::strcmp(argv[a], "--N") == 0) {
+            config.N = std::atoi(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--tEnd") == 0) {
+            config.tEnd = std::atof(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--checksums") == 0) {
+            checksumOutput = argv[++a];
+        } else if (hasValue && std::strcmp(argv[a], "--checksum-every") == 0) {
+            checksumEvery = std::max(1, std::atoi(argv[++a]));
+        }
+    }
+
+    Simulation parallel;
+    initializeSimulation(parallel, config, useSymmetry);
+    // Checksums are taken of the parallel run only; the full field is rebuilt for them
+    std::vector<FieldChecksum> checksums;
+    double parallelTime = runBackend("par_unseq", parallel, parallelStl::stepSimulation, parallelStl::fieldEnergy,
+                                     checksumOutput.empty() ? nullptr : &checksums, checksumEvery);
+    if (!checksumOutput.empty() && !writeChecksums(checksumOutput, checksums)) {
+        std::cerr << "Could not write " << checksumOutput << std::endl;
+    }
+
+    if (serial) {
+        Simulation reference;
+        initializeSimulation(reference, config, useSymmetry);
+        double serialTime = runBackend("serial", reference, stepSimulation, fieldEnergy, nullptr, checksumEvery);
+
+        // Every cell is updated with the same expression, so the screens agree exactly
+        double difference = 0.0;
+        for (int j = 0; j < config.N; ++j) {
+            difference = std::max(difference, std::fabs(parallel.screen[j] - reference.screen[j]));
+        }
+        std::cout << "Speedup: " << serialTime / parallelTime << ", Max screen difference: " << difference << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file parallel_simulation.h
+ * @brief Wave solver parallelised with the C++17 parallel algorithms.
+ *
+ * The functions mirror the time stepping of unitTests/simulation.h and work
+ * on the same Simulation state, so the serial and parallel backends can be
+ * swapped and compared on one kernel. Instead of OpenMP pragmas, every loop
+ * is a std::for_each, std::transform or std::transform_reduce under
+ * std::execution::par_unseq, which libstdc++ runs on TBB. The stencil is
+ * applied row by row: each row is one element of the parallel loop, and the
+ * inner loop over the columns is left to the vectoriser.
+ */
+#ifndef PARALLEL_SIMULATION_H
+#define PARALLEL_SIMULATION_H
+
+#include <vector>
+#include "simulation.h"
+
+namespace parallelStl {
+
+/**
+ * @brief Applies boundary conditions to the grid in parallel.
+ *
+ * @param U Grid values.
+ * @param mask Grid mask.
+ * @param t Current time.
+ * @param xlin Vector storing the spatial coordinates.
+ * @param frequency Frequency of the inflow source.
+ */
+void applyBoundaryConditions(std::vector<std::vector<double>>& U, const std::vector<std::vector<bool>>& mask, double t, const std::vector<double>& xlin, double frequency);
+
+/**
+ * @brief Updates the Laplacian of the grid in parallel, one row per task.
+ *
+ * @param U Current grid values.
+ * @param Uprev Grid values one step earlier.
+ * @param Unew New grid values after Laplacian calculation.
+ * @param mask Grid mask.
+ * @param fac Factor used in the numerical approximation.
+ */
+void updateLaplacian(const std::vector<std::vector<double>>& U, const std::vector<std::vector<double>>& Uprev, std::vector<std::vector<double>>& Unew, const std::vector<std::vector<bool>>& mask, double fac);
+
+/**
+ * @brief Returns the sum of U^2 over the full domain, reduced in parallel.
+ *
+ * @param sim Simulation to read.
+ */
+double fieldEnergy(const Simulation& sim);
+
+/**
+ * @brief Advances a simulation by one time step and accumulates the screen intensity.
+ *
+ * @param sim Simulation initialized with initializeSimulation().
+ */
+void stepSimulation(Simulation& sim);
+
+/**
+ * @brief Runs a simulation until config.tEnd.
+ *
+ * @param config Simulation parameters.
+ * @param useSymmetry Simulate half the columns if the geometry is mirror symmetric.
+ * @return Time-integrated intensity along the detector screen.
+ */
+std::vector<double> runSimulation(const SimulationConfig& config, bool useSymmetry = true);
+
+} // namespace parallelStl
+
+#endif // PARALLEL_SIMULATION_H
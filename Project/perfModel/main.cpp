@@ -0,0 +1,132 @@
+/**
+ * @file main.cpp
+ * @brief Predicts the runtime of the MPI solver for a range of rank counts.
+ *
+ * The kernel throughput is either given with --throughput or calibrated from
+ * the --timing-csv output of one run of the MPI solver (--calibrate). Latency
+ * and bandwidth are fitted from the ping-pong results of Assignment-III/Ex2.
+ * For every valid power-of-two rank count the predicted step time, speedup and
+ * parallel efficiency are printed, followed by the fastest rank count and the
+ * point where the efficiency drops below 50%. Each --validate file is the
+ * timing CSV of another run; its measured time is compared with the prediction.
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "perf_model.h"
+
+// Constants of the MPI solver
+const double boxsize = 1.0;
+const double c = 1.0;
+const double tEnd = 2.0;
+
+int main(int argc, char* argv[]) {
+    std::string intraPath = "../../Assignment-III/Ex2/results/intra.txt";
+    std::string interPath = "../../Assignment-III/Ex2/results/inter.txt";
+    std::string calibratePath;
+    std::vector<std::string> validatePaths;
+    double throughput = 0.0;
+    int N = 256;
+    int haloWidth = 1;
+    int maxRanks = 1024;
+    int coresPerNode = 128;
+    for (int a = 1; a < argc - 1; ++a) {
+        if (std::strcmp(argv[a], "--intra") == 0) {
+            intraPath = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--inter") == 0) {
+            interPath = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--calibrate") == 0) {
+            calibratePath = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--validate") == 0) {
+            validatePaths.push_back(argv[a + 1]);
+        } else if (std::strcmp(argv[a], "--throughput") == 0) {
+            throughput = std::atof(argv[a + 1]);
+        } else if (std::strcmp(argv[a], "--N") == 0) {
+            N = std::atoi(argv[a + 1]);
+        } else if (std::strcmp(argv[a], "--halo-width") == 0) {
+            haloWidth = std::atoi(argv[a + 1]);
+        } else if (std::strcmp(argv[a], "--max-ranks") == 0) {
+            maxRanks = std::atoi(argv[a + 1]);
+        } else if (std::strcmp(argv[a], "--cores-per-node") == 0) {
+            coresPerNode = std::max(1, std::atoi(argv[a + 1]));
+        }
+    }
+
+    // Fallback latencies of bestfit.py for fits with a negative intercept
+    MachineModel model;
+    model.coresPerNode = coresPerNode;
+    if (!fitPingPong(intraPath, 0.7e-6, model.intra) || !fitPingPong(interPath, 1.6e-6, model.inter)) {
+        std::cerr << "Could not fit ping-pong results from " << intraPath << " and " << interPath << std::endl;
+        return 1;
+    }
+
+    int steps = stepCount(N, boxsize, c, tEnd);
+    if (!calibratePath.empty()) {
+        MeasuredRun run;
+        if (!readTiming(calibratePath, run) || run.compute <= 0.0) {
+            std::cerr << "Could not read timings from " << calibratePath << std::endl;
+            return 1;
+        }
+        throughput = cellsPerStep(N, run.ranks, haloWidth) * steps / run.compute;
+    }
+    if (throughput <= 0.0) {
+        std::cerr << "Usage: " << argv[0] << " (--throughput <cells/s> | --calibrate <timing csv>) [--N n] [--halo-width k]"
+                  << " [--max-ranks p] [--cores-per-node n] [--intra file] [--inter file] [--validate <timing csv>]..." << std::endl;
+        return 1;
+    }
+    model.cellsPerSecond = throughput;
+
+    std::printf("N = %d, %d steps, halo width %d\n", N, steps, haloWidth);
+    std::printf("Throughput: %.3e cells/s per rank\n", model.cellsPerSecond);
+    std::printf("Intra-node: latency %.3e s, bandwidth %.3e B/s\n", model.intra.latency, model.intra.bandwidth);
+    std::printf("Inter-node: latency %.3e s, bandwidth %.3e B/s\n\n", model.inter.latency, model.inter.bandwidth);
+
+    std::printf("%8s %14s %14s %14s %12s %10s %10s\n", "Ranks", "Compute [s]", "Halo [s]", "Step [s]", "Run [s]",
+                "Speedup", "Efficiency");
+    double serial = predictStep(model, N, 1, 1).total;
+    double fastest = serial;
+    int fastestRanks = 1;
+    int efficientRanks = 1;
+    for (int ranks = 1; ranks <= maxRanks; ranks *= 2) {
+        if (!validDecomposition(N, ranks, haloWidth)) {
+            continue;
+        }
+        StepPrediction step = predictStep(model, N, ranks, haloWidth);
+        double speedup = serial / step.total;
+        double efficiency = speedup / ranks;
+        std::printf("%8d %14.6e %14.6e %14.6e %12.6f %10.2f %9.1f%%\n", ranks, step.compute, step.halo, step.total,
+                    step.total * steps, speedup, 100.0 * efficiency);
+
+        if (step.total < fastest) {
+            fastest = step.total;
+            fastestRanks = ranks;
+        }
+        if (efficiency >= 0.5) {
+            efficientRanks = ranks;
+        }
+    }
+    std::printf("\nFastest: %d ranks (%.6f s)\n", fastestRanks, fastest * steps);
+    std::printf("Efficiency stays above 50%% up to %d ranks\n", efficientRanks);
+
+    // Compare the prediction with measured runs
+    if (!validatePaths.empty()) {
+        std::printf("\n%-30s %8s %14s %14s %10s\n", "Run", "Ranks", "Measured [s]", "Predicted [s]", "Error");
+    }
+    for (size_t v = 0; v < validatePaths.size(); ++v) {
+        MeasuredRun run;
+        if (!readTiming(validatePaths[v], run)) {
+            std::cerr << "Could not read timings from " << validatePaths[v] << std::endl;
+            continue;
+        }
+        double predicted = predictStep(model, N, run.ranks, haloWidth).total * steps;
+        double error = (predicted - run.total) / run.total;
+        std::printf("%-30s %8d %14.6f %14.6f %9.1f%%\n", validatePaths[v].c_str(), run.ranks, run.total, predicted,
+                    100.0 * error);
+    }
+    return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file perf_model.cpp
+ * @brief Implementation of the performance model declared in perf_model.h.
+ */
+
+#include "perf_model.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+bool fitPingPong(const std::string& path, double fallbackLatency, LinkParameters& link) {
+    std::ifstream in(path.c_str());
+    if (!in) {
+        return false;
+    }
+
+    // Small messages are dominated by protocol switches, so only fit the larger ones
+    std::vector<double> sizes, times;
+    double size, time;
+    while (in >> size >> time) {
+        if (size >= 512) {
+            sizes.push_back(size);
+            times.push_back(time);
+        }
+    }
+    if (sizes.size() < 2) {
+        return false;
+    }
+
+    double n = static_cast<double>(sizes.size());
+    double sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+    for (size_t k = 0; k < sizes.size(); ++k) {
+        sumX += sizes[k];
+        sumY += times[k];
+        sumXX += sizes[k] * sizes[k];
+        sumXY += sizes[k] * times[k];
+    }
+    double slope = (n * sumXY - sumX * sumY) / (n * sumXX - sumX * sumX);
+    double intercept = (sumY - slope * sumX) / n;
+
+    link.bandwidth = slope > 0.0 ? 1.0 / slope : HUGE_VAL;
+    link.latency = intercept < 0.0 ? fallbackLatency : intercept;
+    return true;
+}
+
+int stepCount(int N, double boxsize, double c, double tEnd) {
+    // Same accumulation of t as the solver, so rounding gives the same count
+    double dt = (std::sqrt(2) / 2) * (boxsize / N) / c;
+    int steps = 0;
+    for (double t = 0.0; t < tEnd; t += dt) {
+        ++steps;
+    }
+    return steps;
+}
+
+/**
+ * @brief Returns the rows owned by the largest block, which sets the pace of a step.
+ */
+static int criticalRows(int N, int ranks) {
+    return (N + ranks - 1) / ranks;
+}
+
+double cellsPerStep(int N, int ranks, int haloWidth) {
+    if (ranks == 1) {
+        return static_cast<double>(N) * (N - 2);
+    }
+    // Ghost rows shrink by one per step, so on average k - 1 of them are updated
+    return static_cast<double>(N) * (criticalRows(N, ranks) + haloWidth - 1);
+}
+
+StepPrediction predictStep(const MachineModel& model, int N, int ranks, int haloWidth) {
+    StepPrediction step;
+    step.compute = cellsPerStep(N, ranks, haloWidth) / model.cellsPerSecond;
+    step.halo = 0.0;
+
+    if (ranks > 1) {
+        const LinkParameters& link = ranks > model.coresPerNode ? model.inter : model.intra;
+        double bytes = 2.0 * haloWidth * N * sizeof(double);
+        double exchange = 2.0 * (link.latency + bytes / link.bandwidth);
+        double hidden = static_cast<double>(N) * std::max(0, criticalRows(N, ranks) - 2) / model.cellsPerSecond;
+        step.halo = std::max(0.0, exchange - hidden) / haloWidth;
+    }
+    step.total = step.compute + step.halo;
+    return step;
+}
+
+bool validDecomposition(int N, int ranks, int haloWidth) {
+    return ranks >= 1 && haloWidth >= 1 && haloWidth <= N / ranks;
+}
+
+bool readTiming(const std::string& path, MeasuredRun& run) {
+    std::ifstream in(path.c_str());
+    std::string line;
+    if (!in || !std::getline(in, line)) {
+        return false;
+    }
+
+    // Locate the columns by name so that new phases do not break the reader
+    std::vector<std::string> columns;
+    std::istringstream header(line);
+    std::string name;
+    while (std::getline(header, name, ',')) {
+        columns.push_back(name);
+    }
+    size_t computeColumn = std::find(columns.begin(), columns.end(), "compute") - columns.begin();
+    size_t totalColumn = std::find(columns.begin(), columns.end(), "total") - columns.begin();
+    if (computeColumn == columns.size() || totalColumn == columns.size()) {
+        return false;
+    }
+
+    run.ranks = 0;
+    run.compute = 0.0;
+    run.total = 0.0;
+    while (std::getline(in, line)) {
+        std::vector<double> values;
+        std::istringstream fields(line);
+        std::string field;
+        while (std::getline(fields, field, ',')) {
+            values.push_back(std::atof(field.c_str()));
+        }
+        if (values.size() != columns.size()) {
+            continue;
+        }
+        ++run.ranks;
+        run.compute = std::max(run.compute, values[computeColumn]);
+        run.total = std::max(run.total, values[totalColumn]);
+    }
+    return run.ranks > 0;
+}
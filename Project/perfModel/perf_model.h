@@ -0,0 +1,119 @@
+/**
+ * @file perf_model.h
+ * @brief Analytical model of the step time of the MPI solver.
+ *
+ * The model combines a measured kernel throughput (cells per second per rank)
+ * with the latency and bandwidth of the interconnect, fitted from ping-pong
+ * measurements as in Assignment-III/Ex2/bestfit.py. For a grid of N x N cells
+ * split into row blocks over p ranks with k ghost rows per side, one step of
+ * the slowest (interior) rank costs
+ *
+ *   compute = N * (r + k - 1) / throughput
+ *   halo    = max(0, 2 * (latency + 16 k N / bandwidth) - N * (r - 2) / throughput) / k
+ *
+ * with r = ceil(N/p) the rows of the largest block; like the solver, the first
+ * N mod p ranks own one row more than the others. The k - 1 extra rows are the ghost rows that are updated redundantly on
+ * average, and the halo term is the part of the exchange with both neighbours
+ * (k rows of U and Uprev each) that is not hidden behind the update of the
+ * owned rows. Boundary conditions and I/O are not modelled.
+ */
+#ifndef PERF_MODEL_H
+#define PERF_MODEL_H
+
+#include <string>
+
+/**
+ * @brief Latency and bandwidth of a link.
+ */
+struct LinkParameters {
+    double latency;   /**< Time of an empty message [s] */
+    double bandwidth; /**< Asymptotic bandwidth [bytes/s] */
+};
+
+/**
+ * @brief Measured parameters of the machine.
+ */
+struct MachineModel {
+    double cellsPerSecond; /**< Stencil throughput of one rank */
+    LinkParameters intra;  /**< Link between ranks on the same node */
+    LinkParameters inter;  /**< Link between ranks on different nodes */
+    int coresPerNode;      /**< Ranks per node before messages leave the node */
+};
+
+/**
+ * @brief Predicted time of one step.
+ */
+struct StepPrediction {
+    double compute; /**< Stencil update including redundant ghost rows [s] */
+    double halo;    /**< Exposed halo exchange time [s] */
+    double total;   /**< Sum of both [s] */
+};
+
+/**
+ * @brief Fits latency and bandwidth to ping-pong timings.
+ *
+ * Reads lines of "<message size in bytes> <one-way time in s>" and fits
+ * time = size / bandwidth + latency by least squares to the sizes of at least
+ * 512 bytes. A negative fitted latency is replaced by fallbackLatency.
+ *
+ * @param path Path of the ping-pong results.
+ * @param fallbackLatency Latency used when the fit is not physical.
+ * @param link Receives the fitted parameters.
+ * @return false if the file could not be read or holds too few points.
+ */
+bool fitPingPong(const std::string& path, double fallbackLatency, LinkParameters& link);
+
+/**
+ * @brief Returns the number of steps the solver takes for a grid size.
+ *
+ * @param N Number of cells per side.
+ * @param boxsize Side length of the domain.
+ * @param c Wave speed.
+ * @param tEnd End time.
+ */
+int stepCount(int N, double boxsize, double c, double tEnd);
+
+/**
+ * @brief Returns the number of cells the slowest rank updates per step.
+ *
+ * @param N Number of cells per side.
+ * @param ranks Number of ranks.
+ * @param haloWidth Number of ghost rows per side.
+ */
+double cellsPerStep(int N, int ranks, int haloWidth);
+
+/**
+ * @brief Predicts the time of one step.
+ *
+ * @param model Machine parameters.
+ * @param N Number of cells per side.
+ * @param ranks Number of ranks.
+ * @param haloWidth Number of ghost rows per side.
+ */
+StepPrediction predictStep(const MachineModel& model, int N, int ranks, int haloWidth);
+
+/**
+ * @brief Returns whether the solver accepts a decomposition.
+ *
+ * Any number of ranks splits the rows, as long as every rank, including the
+ * smallest, holds at least haloWidth rows.
+ */
+bool validDecomposition(int N, int ranks, int haloWidth);
+
+/**
+ * @brief Timings of one run, read from the solver's --timing-csv output.
+ */
+struct MeasuredRun {
+    int ranks;      /**< Number of ranks, one line each */
+    double compute; /**< Largest compute time over all ranks [s] */
+    double total;   /**< Largest wall time over all ranks [s] */
+};
+
+/**
+ * @brief Reads the per-rank timing CSV written by the MPI solver.
+ *
+ * @return false if the file could not be read.
+ */
+bool readTiming(const std::string& path, MeasuredRun& run);
+
+#endif // PERF_MODEL_H
@@ -9,8 +9,14 @@
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <string>
+#include "checksum.h"
+#include "memory.h"
 
 // Constants
 const int N = 256; /**< Grid size */
@@ -82,11 +88,12 @@ void applyBoundaryConditions(std::vector<std::vector<double>>& U, const std::vec
  *
  * This function calculates the Laplacian of the grid and updates it using finite difference method.
  * @param U Current grid values
+ * @param Uprev Grid values one step earlier
  * @param Unew Updated grid values after Laplacian calculation
  * @param mask Boundary mask indicating boundary points
  * @param fac Scaling factor
  */
-void updateLaplacian(const std::vector<std::vector<double>>& U, std::vector<std::vector<double>>& Unew, const std::vector<std::vector<bool>>& mask, double fac) {
+void updateLaplacian(const std::vector<std::vector<double>>& U, const std::vector<std::vector<double>>& Uprev, std::vector<std::vector<double>>& Unew, const std::vector<std::vector<bool>>& mask, double fac) {
     for (int i = 1; i < N-1; ++i) {
         for (int j = 1; j < N-1; ++j) {
             if (!mask[i][j]) {
@@ -95,14 +102,52 @@ void updateLaplacian(const std::vector<std::vector<double>>& U, std::vector<std:
                 double ULY = U[i][j-1];
                 double URY = U[i][j+1];
                 double laplacian = (ULX + URX + ULY + URY - 4.0 * U[i][j]);
-                Unew[i][j] = 2.0 * U[i][j] - U[i][j] + fac * laplacian;
+                Unew[i][j] = 2.0 * U[i][j] - Uprev[i][j] + fac * laplacian;
             }
         }
     }
 }
 
 
-int main() {
+/**
+ * @brief Returns the memory the fields of a grid of n x n cells will take.
+ *
+ * @param n Grid size.
+ */
+MemoryReport projectMemory(int n) {
+    MemoryReport report;
+    report.add("U", nestedDoubleBytes(n, n));
+    report.add("Uprev", nestedDoubleBytes(n, n));
+    report.add("Unew", nestedDoubleBytes(n, n));
+    report.add("mask", nestedMaskBytes(n, n));
+    report.add("xlin", flatDoubleBytes(1, n));
+    return report;
+}
+
+int main(int argc, char* argv[]) {
+    // Optional arguments: --memory <n> projects the memory of an n x n grid
+    // before allocating; for any other n than N it stops after the projection.
+    // --checksums <file> --checksum-every <steps> write field checksums
+    int memoryN = 0;
+    std::string checksumOutput;
+    int checksumEvery = 10;
+    for (int a = 1; a < argc - 1; ++a) {
+        if (std::strcmp(argv[a], "--memory") == 0) {
+            memoryN = std::atoi(argv[a + 1]);
+        } else if (std::strcmp(argv[a], "--checksums") == 0) {
+            checksumOutput = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--checksum-every") == 0) {
+            checksumEvery = std::max(1, std::atoi(argv[a + 1]));
+        }
+    }
+    if (memoryN > 0) {
+        projectMemory(memoryN).print(std::cerr, "Projected memory for N = " + std::to_string(memoryN),
+                                     static_cast<size_t>(memoryN) * memoryN);
+        if (memoryN != N) {
+            return 0;
+        }
+    }
+
     double dx = boxsize / N;
     double dt = (std::sqrt(2) / 2) * dx / c;
     double fac = dt * dt * c * c / (dx * dx);
@@ -117,9 +162,14 @@ int main() {
     std::vector<std::vector<double>> Unew(N, std::vector<double>(N, 0.0));
 
     double t = 0.0;
+    int step = 0;
+    std::vector<FieldChecksum> checksums;
+    if (!checksumOutput.empty()) {
+        checksums.push_back(fieldChecksum(U, step));
+    }
 
     while (t < tEnd) {
-        updateLaplacian(U, Unew, mask, fac);
+        updateLaplacian(U, Uprev, Unew, mask, fac);
 
         Uprev = U;
         U = Unew;
@@ -127,7 +177,27 @@ int main() {
         applyBoundaryConditions(U, mask, t, xlin);
 
         t += dt;
+        ++step;
         std::cout << t << std::endl;
+
+        if (!checksumOutput.empty() && (step % checksumEvery == 0 || t >= tEnd)) {
+            checksums.push_back(fieldChecksum(U, step));
+        }
+    }
+
+    if (!checksumOutput.empty() && !writeChecksums(checksumOutput, checksums)) {
+        std::cerr << "Could not write " << checksumOutput << std::endl;
+    }
+
+    if (memoryN > 0) {
+        MemoryReport report;
+        report.add("U", bytesOf(U));
+        report.add("Uprev", bytesOf(Uprev));
+        report.add("Unew", bytesOf(Unew));
+        report.add("mask", bytesOf(mask));
+        report.add("xlin", bytesOf(xlin));
+        report.print(std::cerr, "Allocated memory", static_cast<size_t>(N) * N);
+        printResidentMemory(std::cerr);
     }
     return 0;
 }
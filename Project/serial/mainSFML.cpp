@@ -86,11 +86,12 @@ void applyBoundaryConditions(std::vector<std::vector<double>>& U, const std::vec
  * 
  * This function calculates the Laplacian of the grid and updates it using finite difference method.
  * @param U Current grid values
+ * @param Uprev Grid values one step earlier
  * @param Unew Updated grid values after Laplacian calculation
  * @param mask Boundary mask indicating boundary points
  * @param fac Scaling factor
  */
-void updateLaplacian(const std::vector<std::vector<double>>& U, std::vector<std::vector<double>>& Unew, const std::vector<std::vector<bool>>& mask, double fac) {
+void updateLaplacian(const std::vector<std::vector<double>>& U, const std::vector<std::vector<double>>& Uprev, std::vector<std::vector<double>>& Unew, const std::vector<std::vector<bool>>& mask, double fac) {
     for (int i = 1; i < N-1; ++i) {
         for (int j = 1; j < N-1; ++j) {
             if (!mask[i][j]) {
@@ -99,7 +100,7 @@ void updateLaplacian(const std::vector<std::vector<double>>& U, std::vector<std:
                 double ULY = U[i][j-1];
                 double URY = U[i][j+1];
                 double laplacian = (ULX + URX + ULY + URY - 4.0 * U[i][j]);
-                Unew[i][j] = 2.0 * U[i][j] - U[i][j] + fac * laplacian;
+                Unew[i][j] = 2.0 * U[i][j] - Uprev[i][j] + fac * laplacian;
             }
         }
     }
@@ -0,0 +1,184 @@
+/**
+ * @file main.cpp
+ * @brief Runs a grid of serial wave simulations concurrently on one node.
+ *
+ * Small grids do not scale with threads, so throughput comes from running many
+ * independent serial simulations at once. The parameter grid is read from a
+ * text file with one parameter per line followed by its values, for example:
+ *
+ *   N           128 256
+ *   frequency   5 10 20
+ *   slitSpacing 0.25 0.3125
+ *
+ * Every combination is one job. Jobs are sorted by estimated cost (N^3 * tEnd),
+ * run on a work-stealing pool with one worker per core, and summarised in
+ * index.csv in the output directory together with one screen intensity file
+ * per job. With --cache, results are looked up in and added to a result cache.
+ * With --mode far-field every job only computes the Fraunhofer approximation
+ * of farField/far_field.h instead of running the time-domain solver.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <sys/stat.h>
+#include "far_field.h"
+#include "parameter_grid.h"
+#include "result_cache.h"
+#include "simulation.h"
+#include "work_stealing_pool.h"
+
+/**
+ * @brief One simulation of the sweep and its outcome.
+ */
+struct SweepJob {
+    int id;                     /**< Position in the parameter grid */
+    SimulationConfig config;    /**< Parameters of the run */
+    std::vector<double> screen; /**< Time-integrated screen intensity */
+    double seconds;             /**< Wall time of the run */
+    int worker;                 /**< Worker that ran the job */
+    ResultCache::Outcome cache; /**< How the result cache served the job */
+};
+
+/**
+ * @brief Sets a configuration parameter by name.
+ *
+ * @return false if the name is unknown.
+ */
+bool setParameter(SimulationConfig& config, const std::string& name, double value) {
+    if (name == "N") config.N = static_cast<int>(value);
+    else if (name == "boxsize") config.boxsize = value;
+    else if (name == "c") config.c = value;
+    else if (name == "tEnd") config.tEnd = value;
+    else if (name == "frequency") config.frequency = value;
+    else if (name == "slitWidth") config.slitWidth = value;
+    else if (name == "slitSpacing") config.slitSpacing = value;
+    else if (name == "screen") config.screen = value;
+    else return false;
+    return true;
+}
+
+/**
+ * @brief Writes the screen intensity of every job and the index of all jobs.
+ */
+void writeResults(const std::string& outputDir, const std::vector<SweepJob>& jobs) {
+    std::string indexPath = outputDir + "/index.csv";
+    FILE* index = std::fopen(indexPath.c_str(), "w");
+    if (index == nullptr) {
+        std::cerr << "Could not open " << indexPath << " for writing" << std::endl;
+        return;
+    }
+    std::fprintf(index, "id,N,boxsize,c,tEnd,frequency,slitWidth,slitSpacing,screen,seconds,worker,cache,peak,result\n");
+
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        const SweepJob& job = jobs[j];
+        char name[32];
+        std::snprintf(name, sizeof(name), "run_%04d.txt", job.id);
+
+        std::ofstream out((outputDir + "/" + name).c_str());
+        for (size_t k = 0; k < job.screen.size(); ++k) {
+            out << job.screen[k] << "\n";
+        }
+
+        double peak = job.screen.empty() ? 0.0 : *std::max_element(job.screen.begin(), job.screen.end());
+        const SimulationConfig& c = job.config;
+        std::fprintf(index, "%d,%d,%g,%g,%g,%g,%g,%g,%g,%.6f,%d,%s,%g,%s\n", job.id, c.N, c.boxsize, c.c, c.tEnd,
+                     c.frequency, c.slitWidth, c.slitSpacing, c.screen, job.seconds, job.worker,
+                     ResultCache::outcomeName(job.cache), peak, name);
+    }
+    std::fclose(index);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <grid file> [--workers n] [--output dir] [--cache dir]"
+                  << " [--mode time-domain|far-field]" << std::endl;
+        return 1;
+    }
+
+    int workers = std::max(1u, std::thread::hardware_concurrency());
+    std::string outputDir = "sweep_results";
+    std::string cacheDir;
+    bool farField = false;
+    for (int a = 2; a < argc - 1; ++a) {
+        if (std::strcmp(argv[a], "--workers") == 0) {
+            workers = std::max(1, std::atoi(argv[a + 1]));
+        } else if (std::strcmp(argv[a], "--output") == 0) {
+            outputDir = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--cache") == 0) {
+            cacheDir = argv[a + 1];
+        } else if (std::strcmp(argv[a], "--mode") == 0) {
+            farField = std::strcmp(argv[a + 1], "far-field") == 0;
+        }
+    }
+
+    std::vector<SimulationConfig> configs;
+    if (!readParameterGrid(argv[1], defaultConfig(), setParameter, configs)) {
+        return 1;
+    }
+    mkdir(outputDir.c_str(), 0755);
+
+    std::vector<SweepJob> jobs(configs.size());
+    for (size_t j = 0; j < configs.size(); ++j) {
+        jobs[j].id = static_cast<int>(j);
+        jobs[j].config = configs[j];
+        jobs[j].seconds = 0.0;
+        jobs[j].worker = -1;
+        jobs[j].cache = ResultCache::MISS;
+    }
+
+    std::unique_ptr<ResultCache> cacheOwner(cacheDir.empty() ? nullptr : new ResultCache(cacheDir));
+    ResultCache* cache = cacheOwner.get();
+
+    // Largest jobs first: the cost grows with N^2 cells times N steps per unit time
+    std::vector<SweepJob*> order;
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        order.push_back(&jobs[j]);
+    }
+    std::stable_sort(order.begin(), order.end(), [](const SweepJob* a, const SweepJob* b) {
+        double costA = static_cast<double>(a->config.N) * a->config.N * a->config.N * a->config.tEnd;
+        double costB = static_cast<double>(b->config.N) * b->config.N * b->config.N * b->config.tEnd;
+        return costA > costB;
+    });
+
+    std::vector<WorkStealingPool::Job> tasks;
+    for (size_t j = 0; j < order.size(); ++j) {
+        SweepJob* job = order[j];
+        tasks.push_back([job, cache, farField](int worker) {
+            auto start = std::chrono::high_resolution_clock::now();
+            if (farField) {
+                job->screen = farFieldScreen(job->config);
+            } else {
+                job->screen = cache ? cache->run(job->config, job->cache) : runSimulation(job->config);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            job->seconds = std::chrono::duration<double>(end - start).count();
+            job->worker = worker;
+        });
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    WorkStealingPool pool(workers);
+    std::vector<int> stolen = pool.run(tasks);
+    auto end = std::chrono::high_resolution_clock::now();
+    double duration = std::chrono::duration<double>(end - start).count();
+
+    writeResults(outputDir, jobs);
+
+    int totalStolen = 0;
+    for (size_t w = 0; w < stolen.size(); ++w) {
+        totalStolen += stolen[w];
+    }
+    std::cout << "Jobs: " << jobs.size() << ", Workers: " << workers << ", Stolen: " << totalStolen
+              << ", Execution time: " << duration << " seconds" << std::endl;
+    return 0;
+}
@@ -0,0 +1,238 @@
+/**
+ * @file result_cache.cpp
+ * @brief Implementation of the result cache declared in result_cache.h.
+ */
+
+#include "result_cache.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Version of the state file layout; entries of other versions are ignored.
+ *
+ * Version 2 added Uprev, without which a resumed leapfrog run restarts wrongly.
+ */
+static const int32_t stateVersion = 2;
+
+/**
+ * @brief Reads an n x n field into the stored columns of a grid.
+ */
+static bool readField(FILE* file, int n, std::vector<std::vector<double>>& grid) {
+    // States hold the full field; a mirrored simulation keeps the leading columns
+    std::vector<double> row(n);
+    for (int i = 0; i < n; ++i) {
+        if (std::fread(row.data(), sizeof(double), n, file) != static_cast<size_t>(n)) {
+            return false;
+        }
+        std::copy(row.begin(), row.begin() + grid[i].size(), grid[i].begin());
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the full n x n field of a grid with stored columns.
+ */
+static void writeField(FILE* file, int n, const std::vector<std::vector<double>>& grid) {
+    const int cols = static_cast<int>(grid[0].size());
+    std::vector<double> row(n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            row[j] = grid[i][storedColumn(j, n, cols)];
+        }
+        std::fwrite(row.data(), sizeof(double), n, file);
+    }
+}
+
+ResultCache::ResultCache(const std::string& directory) : directory(directory) {
+    mkdir(directory.c_str(), 0755);
+}
+
+std::string ResultCache::describe(const SimulationConfig& config, bool withEndTime) {
+    // %.17g round-trips every double, so equal descriptions mean equal parameters
+    char text[512];
+    std::snprintf(text, sizeof(text),
+                  "version=%d precision=double N=%d boxsize=%.17g c=%.17g frequency=%.17g "
+                  "slitWidth=%.17g slitSpacing=%.17g screen=%.17g",
+                  solverVersion, config.N, config.boxsize, config.c, config.frequency,
+                  config.slitWidth, config.slitSpacing, config.screen);
+    std::string description(text);
+    if (withEndTime) {
+        std::snprintf(text, sizeof(text), " tEnd=%.17g", config.tEnd);
+        description += text;
+    }
+    return description;
+}
+
+std::string ResultCache::hash(const std::string& text) {
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t k = 0; k < text.size(); ++k) {
+        h ^= static_cast<unsigned char>(text[k]);
+        h *= 1099511628211ULL;
+    }
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(h));
+    return hex;
+}
+
+const char* ResultCache::outcomeName(Outcome outcome) {
+    switch (outcome) {
+        case HIT:     return "hit";
+        case PARTIAL: return "partial";
+        default:      return "miss";
+    }
+}
+
+/**
+ * @brief Records the description of an entry, or checks it against the recorded one.
+ *
+ * @return false if the entry belongs to a different configuration with the same hash.
+ */
+static bool claimEntry(const std::string& entryDir, const std::string& description) {
+    mkdir(entryDir.c_str(), 0755);
+    std::string path = entryDir + "/config.txt";
+
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (file != nullptr) {
+        char recorded[512] = { 0 };
+        bool read = std::fgets(recorded, sizeof(recorded), file) != nullptr;
+        std::fclose(file);
+        return read && description == recorded;
+    }
+
+    file = std::fopen(path.c_str(), "w");
+    if (file != nullptr) {
+        std::fputs(description.c_str(), file);
+        std::fclose(file);
+    }
+    return true;
+}
+
+std::vector<double> ResultCache::run(const SimulationConfig& config, Outcome& outcome,
+                                     std::vector<std::vector<double>>* field) {
+    std::string description = describe(config, false);
+    std::string entryDir = directory + "/" + hash(description);
+    if (!claimEntry(entryDir, description)) {
+        // Hash collision with another configuration: simulate without caching
+        outcome = MISS;
+        Simulation sim;
+        initializeSimulation(sim, config);
+        while (sim.t < config.tEnd) {
+            stepSimulation(sim);
+        }
+        if (field != nullptr) {
+            *field = fullField(sim);
+        }
+        return sim.screen;
+    }
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "t_%.17g.state", config.tEnd);
+    std::string path = entryDir + "/" + name;
+
+    Simulation sim;
+    if (load(path, config, sim)) {
+        outcome = HIT;
+        if (field != nullptr) {
+            *field = fullField(sim);
+        }
+        return sim.screen;
+    }
+
+    // Look for the latest state that ended before the requested end time
+    double bestEnd = -1.0;
+    std::string bestPath;
+    DIR* dir = opendir(entryDir.c_str());
+    if (dir != nullptr) {
+        struct dirent* entry;
+        const std::string prefix = "t_";
+        const std::string suffix = ".state";
+        while ((entry = readdir(dir)) != nullptr) {
+            std::string file = entry->d_name;
+            if (file.size() <= prefix.size() + suffix.size() || file.compare(0, prefix.size(), prefix) != 0
+                || file.compare(file.size() - suffix.size(), suffix.size(), suffix) != 0) {
+                continue;
+            }
+            double end = std::strtod(file.substr(prefix.size(), file.size() - prefix.size() - suffix.size()).c_str(), nullptr);
+            if (end < config.tEnd && end > bestEnd) {
+                bestEnd = end;
+                bestPath = entryDir + "/" + file;
+            }
+        }
+        closedir(dir);
+    }
+
+    if (!bestPath.empty() && load(bestPath, config, sim)) {
+        outcome = PARTIAL;
+    } else {
+        outcome = MISS;
+        initializeSimulation(sim, config);
+    }
+
+    while (sim.t < config.tEnd) {
+        stepSimulation(sim);
+    }
+    store(path, sim);
+    if (field != nullptr) {
+        *field = fullField(sim);
+    }
+    return sim.screen;
+}
+
+bool ResultCache::load(const std::string& path, const SimulationConfig& config, Simulation& sim) const {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    char magic[4];
+    int32_t version = 0;
+    int32_t n = 0;
+    double t = 0.0;
+    bool ok = std::fread(magic, 1, 4, file) == 4 && std::string(magic, 4) == "WSTA"
+           && std::fread(&version, sizeof(version), 1, file) == 1 && version == stateVersion
+           && std::fread(&n, sizeof(n), 1, file) == 1 && n == config.N
+           && std::fread(&t, sizeof(t), 1, file) == 1;
+
+    if (ok) {
+        initializeSimulation(sim, config);
+        sim.t = t;
+        ok = std::fread(sim.screen.data(), sizeof(double), n, file) == static_cast<size_t>(n)
+          && readField(file, n, sim.U) && readField(file, n, sim.Uprev);
+    }
+    std::fclose(file);
+    return ok;
+}
+
+void ResultCache::store(const std::string& path, const Simulation& sim) const {
+    // Write to a private file first so concurrent readers never see a partial entry
+    static std::atomic<int> counter(0);
+    char suffix[64];
+    std::snprintf(suffix, sizeof(suffix), ".tmp%ld.%d", static_cast<long>(getpid()), counter++);
+    std::string temporary = path + suffix;
+
+    FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (file == nullptr) {
+        return;
+    }
+    int32_t n = sim.config.N;
+    std::fwrite("WSTA", 1, 4, file);
+    std::fwrite(&stateVersion, sizeof(stateVersion), 1, file);
+    std::fwrite(&n, sizeof(n), 1, file);
+    std::fwrite(&sim.t, sizeof(sim.t), 1, file);
+    std::fwrite(sim.screen.data(), sizeof(double), n, file);
+    writeField(file, n, sim.U);
+    writeField(file, n, sim.Uprev);
+    bool ok = std::fclose(file) == 0;
+
+    if (ok) {
+        std::rename(temporary.c_str(), path.c_str());
+    } else {
+        std::remove(temporary.c_str());
+    }
+}
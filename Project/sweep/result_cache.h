@@ -0,0 +1,81 @@
+/**
+ * @file result_cache.h
+ * @brief Content-addressed cache of simulation results.
+ *
+ * Results are stored under a hash of every parameter that affects them: the
+ * grid size, physics, geometry, source, floating point precision and solver
+ * version. Every entry holds the full state of the simulation at its end time,
+ * so a request that only extends tEnd resumes from the latest earlier entry
+ * instead of starting over. Since the time stepping is deterministic a resumed
+ * run gives exactly the same result as a fresh one.
+ *
+ * Layout: <directory>/<hash of everything but tEnd>/t_<tEnd>.state, holding
+ * char[4] "WSTA", int32 version, int32 N, double t, the screen, then U and
+ * Uprev of the full N x N domain (native byte order). Entries of another
+ * version are ignored and simulated again.
+ */
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <string>
+#include <vector>
+#include "simulation.h"
+
+/**
+ * @brief Returns cached results or runs and caches the simulation.
+ */
+class ResultCache {
+public:
+    /**
+     * @brief How a request was served.
+     */
+    enum Outcome {
+        MISS,    /**< Simulated from the start */
+        HIT,     /**< Served from the cache without simulating */
+        PARTIAL  /**< Resumed from a cached state with an earlier end time */
+    };
+
+    /**
+     * @brief Creates a cache in a directory, creating the directory if needed.
+     *
+     * @param directory Root directory of the cache.
+     */
+    explicit ResultCache(const std::string& directory);
+
+    /**
+     * @brief Returns the screen intensity of a configuration.
+     *
+     * @param config Simulation parameters.
+     * @param outcome Receives how the request was served.
+     * @param field Receives the full field at the end time, if not null.
+     * @return Time-integrated intensity along the detector screen.
+     */
+    std::vector<double> run(const SimulationConfig& config, Outcome& outcome,
+                            std::vector<std::vector<double>>* field = nullptr);
+
+    /**
+     * @brief Returns the canonical description of a configuration that is hashed.
+     *
+     * @param config Simulation parameters.
+     * @param withEndTime Whether tEnd is part of the description.
+     */
+    static std::string describe(const SimulationConfig& config, bool withEndTime);
+
+    /**
+     * @brief Returns the 64-bit FNV-1a hash of a string as 16 hex digits.
+     */
+    static std::string hash(const std::string& text);
+
+    /**
+     * @brief Returns a printable name of an outcome.
+     */
+    static const char* outcomeName(Outcome outcome);
+
+private:
+    bool load(const std::string& path, const SimulationConfig& config, Simulation& sim) const;
+    void store(const std::string& path, const Simulation& sim) const;
+
+    std::string directory;
+};
+
+#endif // RESULT_CACHE_H
@@ -0,0 +1,69 @@
+/**
+ * @file work_stealing_pool.cpp
+ * @brief Implementation of the work-stealing pool declared in work_stealing_pool.h.
+ */
+
+#include "work_stealing_pool.h"
+#include <algorithm>
+#include <thread>
+
+WorkStealingPool::WorkStealingPool(int workers) : workers(std::max(1, workers)), queues(std::max(1, workers)) {
+}
+
+bool WorkStealingPool::popLocal(int worker, const Job*& job) {
+    Queue& queue = queues[worker];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (queue.jobs.empty()) {
+        return false;
+    }
+    job = queue.jobs.back();
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(int thief, const Job*& job) {
+    // Visit the other workers starting with the next one so thieves spread out
+    for (int offset = 1; offset < workers; ++offset) {
+        Queue& victim = queues[(thief + offset) % workers];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::work(int worker, int& stolen) {
+    // No jobs are added while the pool runs, so empty queues everywhere mean done
+    const Job* job;
+    for (;;) {
+        if (popLocal(worker, job)) {
+            (*job)(worker);
+        } else if (steal(worker, job)) {
+            ++stolen;
+            (*job)(worker);
+        } else {
+            return;
+        }
+    }
+}
+
+std::vector<int> WorkStealingPool::run(const std::vector<Job>& jobs) {
+    // Deal out in reverse so that every worker pops its jobs in the given order
+    for (size_t j = jobs.size(); j-- > 0;) {
+        queues[j % workers].jobs.push_back(&jobs[j]);
+    }
+
+    std::vector<int> stolen(workers, 0);
+    std::vector<std::thread> threads;
+    for (int w = 1; w < workers; ++w) {
+        threads.push_back(std::thread(&WorkStealingPool::work, this, w, std::ref(stolen[w])));
+    }
+    work(0, stolen[0]);
+    for (size_t t = 0; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+    return stolen;
+}
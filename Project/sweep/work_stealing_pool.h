@@ -0,0 +1,60 @@
+/**
+ * @file work_stealing_pool.h
+ * @brief Work-stealing pool that runs a fixed set of independent jobs.
+ *
+ * Every worker owns a deque of jobs. A worker takes jobs from the back of its
+ * own deque and, once it runs dry, steals from the front of the other workers'
+ * deques. Jobs are dealt out round robin in the order given, so passing the
+ * most expensive jobs first keeps the tail of the run short.
+ */
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Runs jobs on a fixed number of worker threads with work stealing.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @brief Job to run; receives the index of the worker running it.
+     */
+    typedef std::function<void(int)> Job;
+
+    /**
+     * @brief Creates a pool.
+     *
+     * @param workers Number of worker threads.
+     */
+    explicit WorkStealingPool(int workers);
+
+    /**
+     * @brief Runs all jobs and returns when every job has finished.
+     *
+     * @param jobs Jobs to run, dealt out round robin in this order.
+     * @return Number of jobs each worker took from another worker.
+     */
+    std::vector<int> run(const std::vector<Job>& jobs);
+
+private:
+    /**
+     * @brief Job queue of one worker.
+     */
+    struct Queue {
+        std::mutex lock;
+        std::deque<const Job*> jobs;
+    };
+
+    bool popLocal(int worker, const Job*& job);
+    bool steal(int thief, const Job*& job);
+    void work(int worker, int& stolen);
+
+    int workers;
+    std::vector<Queue> queues;
+};
+
+#endif // WORK_STEALING_POOL_H
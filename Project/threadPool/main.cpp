@@ -0,0 +1,105 @@
+/**
+ * @file main.cpp
+ * @brief Runs the double slit on a persistent pool of spinning, pinned threads.
+ *
+ * For small grids a step takes only tens of microseconds, so the cost of
+ * starting threads and of sleeping in a barrier matters. This backend starts
+ * its threads once per thread count and synchronises the steps with a single
+ * spinning barrier, to compare against the fork/join of the OpenMP solver.
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "checksum.h"
+#include "partition.h"
+#include "pool_solver.h"
+#include "thread_pool.h"
+#include "trace.h"
+
+int main(int argc, char* argv[]) {
+    // Optional arguments: --threads <n> --N <n> --tEnd <t> --spin <polls> --no-pin --trace <file>
+    //                     --checksums <file> --checksum-every <steps>
+    SimulationConfig config = defaultConfig();
+    std::vector<int> threads;
+    int spinBudget = 100000;
+    bool pin = true;
+    std::string traceOutput;
+    std::string checksumOutput;
+    int checksumEvery = 10;
+    for (int a = 1; a < argc; ++a) {
+        bool hasValue = a + 1 < argc;
+        if (std::strcmp(argv[a], "--no-pin") == 0) {
+            pin = false;
+        } else if (hasValue && std::strcmp(argv[a], "--threads") == 0) {
+            threads.assign(1, std::max(1, std::atoi(argv[++a])));
+        } else if (hasValue && std::strcmp(argv[a], "--N") == 0) {
+            config.N = std::atoi(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--tEnd") == 0) {
+            config.tEnd = std::atof(argv[++a]);
+        } else if (hasValue && std::strcmp(argv[a], "--spin") == 0) {
+            spinBudget = std::max(0, std::atoi(argv[++a]));
+        } else if (hasValue && std::strcmp(argv[a], "--trace") == 0) {
+            traceOutput = argv[++a];
+        } else if (hasValue && std::strcmp(argv[a], "--checksums") == 0) {
+            checksumOutput = argv[++a];
+        } else if (hasValue && std::strcmp(argv[a], "--checksum-every") == 0) {
+            checksumEvery = std::max(1, std::atoi(argv[++a]));
+        }
+    }
+
+    // By default powers of two up to the number of cores
+    if (threads.empty()) {
+        int cores = std::max(1u, std::thread::hardware_concurrency());
+        for (int count = 1; count < cores; count *= 2) {
+            threads.push_back(count);
+        }
+        threads.push_back(cores);
+    }
+
+    for (size_t k = 0; k < threads.size(); ++k) {
+        PoolGrid grid;
+        initializePoolGrid(grid, config);
+
+        // Bands of rows with equal active cells, fixed for the whole run
+        std::vector<int> bounds = balancedRowPartition(grid.mask, threads[k]);
+        double imbalance = partitionImbalance(partitionWork(grid.mask, bounds));
+
+        // Starting the threads is not part of the time steps
+        ThreadPool pool(threads[k], spinBudget, pin);
+
+        // One checksum file per thread count, e.g. checksums.txt.4
+        std::vector<FieldChecksum> checksums;
+        std::vector<FieldChecksum>* record = checksumOutput.empty() ? nullptr : &checksums;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        long steps = runPoolSimulation(pool, grid, bounds, record, checksumEvery);
+        auto end = std::chrono::high_resolution_clock::now();
+        double duration = std::chrono::duration<double>(end - start).count();
+
+        std::string checksumFile = checksumOutput + "." + std::to_string(threads[k]);
+        if (record != nullptr && !writeChecksums(checksumFile, checksums)) {
+            std::cerr << "Could not write " << checksumFile << std::endl;
+        }
+
+        std::cout << "Threads: " << threads[k] << ", Execution time: " << duration << " seconds"
+                  << ", Time per step: " << (steps > 0 ? 1e6 * duration / steps : 0.0) << " us"
+                  << ", Partition imbalance: " << imbalance
+                  << ", Barrier fallbacks: " << pool.barrierFallbacks()
+                  << ", Field energy: " << poolFieldEnergy(grid) << std::endl;
+    }
+
+    if (!traceOutput.empty()) {
+        if (!traceEnabled) {
+            std::cerr << "Tracing is not compiled in, rebuild with make TRACE=1" << std::endl;
+        } else if (!traceWrite(traceOutput, traceEvents(0, "threadPool"))) {
+            std::cerr << "Could not write " << traceOutput << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file pool_solver.cpp
+ * @brief Implementation of the pool solver declared in pool_solver.h.
+ */
+
+#include "pool_solver.h"
+#include <cmath>
+#include <utility>
+#include "trace.h"
+
+void initializePoolGrid(PoolGrid& grid, const SimulationConfig& config) {
+    const int n = config.N;
+    grid.config = config;
+    grid.xlin.assign(n, 0.0);
+    grid.U.assign(n, std::vector<double>(n, 0.0));
+    grid.Uprev.assign(n, std::vector<double>(n, 0.0));
+    grid.mask.assign(n, std::vector<bool>(n, false));
+    initializeGrid(grid.U, grid.mask, grid.xlin, config);
+
+    double dx = config.boxsize / n;
+    grid.dt = (std::sqrt(2)/2) * dx / config.c;
+    grid.fac = grid.dt*grid.dt * config.c*config.c / (dx*dx);
+}
+
+long runPoolSimulation(ThreadPool& pool, PoolGrid& grid, const std::vector<int>& bounds,
+                       std::vector<FieldChecksum>* checksums, int checksumEvery) {
+    const int n = grid.config.N;
+    long steps = 0;
+
+    // Parts of the checksum per thread, alternating by step so that thread 0
+    // reads one set while the others may already fill the other
+    std::vector<FieldChecksum> parts[2];
+    if (checksums != nullptr) {
+        checksums->push_back(fieldChecksum(grid.U, 0));
+        parts[0].assign(pool.size(), emptyChecksum(0));
+        parts[1].assign(pool.size(), emptyChecksum(0));
+    }
+
+    pool.run([&](int thread) {
+        std::vector<std::vector<double>>* current = &grid.U;
+        std::vector<std::vector<double>>* next = &grid.Uprev;
+        const std::vector<std::vector<bool>>& mask = grid.mask;
+        const double fac = grid.fac;
+
+        // Every thread advances its own copy of the time identically
+        double t = 0.0;
+        long step = 0;
+        while (t < grid.config.tEnd) {
+            const std::vector<std::vector<double>>& U = *current;
+            std::vector<std::vector<double>>& Unew = *next;
+            {
+                TRACE_SCOPE("compute");
+                for (int i = bounds[thread]; i < bounds[thread + 1]; ++i) {
+                    for (int j = 1; j < n-1; ++j) {
+                        if (!mask[i][j]) {
+                            double laplacian = (U[i-1][j] + U[i+1][j] + U[i][j-1] + U[i][j+1] - 4.0 * U[i][j]);
+                            Unew[i][j] = 2.0 * U[i][j] - Unew[i][j] + fac * laplacian;
+                        }
+                    }
+                }
+            }
+
+            // Row 0 of the new field is read only after the barrier
+            if (thread == 0) {
+                TRACE_SCOPE("boundary");
+                double amplitude = std::sin(2.0 * grid.config.frequency * M_PI * t);
+                for (int j = 0; j < n; ++j) {
+                    Unew[0][j] = amplitude * std::pow(std::sin(M_PI * grid.xlin[j]), 2);
+                }
+            }
+
+            // The same test as the loop condition, so every thread agrees on the last step
+            bool record = checksums != nullptr && ((step + 1) % checksumEvery == 0 || !(t + grid.dt < grid.config.tEnd));
+            if (record) {
+                TRACE_SCOPE("checksum");
+                FieldChecksum& part = parts[step % 2][thread];
+                part = emptyChecksum(step + 1);
+                for (int i = bounds[thread]; i < bounds[thread + 1]; ++i) {
+                    addRow(part, i, Unew[i].data(), n);
+                }
+                if (thread == 0) {
+                    addRow(part, 0, Unew[0].data(), n);
+                    addRow(part, n - 1, Unew[n - 1].data(), n);
+                }
+            }
+
+            {
+                TRACE_SCOPE("barrier");
+                pool.barrier();
+            }
+
+            if (record && thread == 0) {
+                FieldChecksum total = emptyChecksum(step + 1);
+                for (const FieldChecksum& part : parts[step % 2]) {
+                    addChecksum(total, part);
+                }
+                checksums->push_back(total);
+            }
+            std::swap(current, next);
+            t += grid.dt;
+            ++step;
+        }
+
+        if (thread == 0) {
+            steps = step;
+        }
+    });
+
+    // After an odd number of steps the latest field is in Uprev
+    if (steps % 2 == 1) {
+        grid.U.swap(grid.Uprev);
+    }
+    return steps;
+}
+
+double poolFieldEnergy(const PoolGrid& grid) {
+    double energy = 0.0;
+    for (size_t i = 0; i < grid.U.size(); ++i) {
+        for (size_t j = 0; j < grid.U[i].size(); ++j) {
+            energy += grid.U[i][j] * grid.U[i][j];
+        }
+    }
+    return energy;
+}
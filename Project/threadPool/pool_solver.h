@@ -0,0 +1,65 @@
+/**
+ * @file pool_solver.h
+ * @brief Leapfrog wave solver whose threads run the whole time loop.
+ *
+ * All threads of a ThreadPool step the simulation together, each over its own
+ * band of rows from balancedRowPartition(). The update of a cell only reads
+ * its own old value, so the new field overwrites the previous one in place and
+ * the two fields swap roles every step without copying. Masked cells, which
+ * include the outer boundary, are never written and stay zero, and thread 0
+ * sets the inflow row of the new field while the others compute. One barrier
+ * per step is therefore the only synchronisation.
+ *
+ * Field checksums are computed incrementally: every thread adds up its own
+ * band while it is still in cache, and thread 0 combines the parts after the
+ * barrier.
+ */
+#ifndef POOL_SOLVER_H
+#define POOL_SOLVER_H
+
+#include <vector>
+#include "checksum.h"
+#include "simulation.h"
+#include "thread_pool.h"
+
+/**
+ * @brief Fields of a simulation run on the pool.
+ */
+struct PoolGrid {
+    SimulationConfig config;
+    std::vector<double> xlin;
+    std::vector<std::vector<double>> U;     /**< Field at the current time */
+    std::vector<std::vector<double>> Uprev; /**< Field one step earlier */
+    std::vector<std::vector<bool>> mask;
+    double dt;
+    double fac;
+};
+
+/**
+ * @brief Allocates and initializes the fields.
+ *
+ * @param grid Grid to initialize.
+ * @param config Simulation parameters.
+ */
+void initializePoolGrid(PoolGrid& grid, const SimulationConfig& config);
+
+/**
+ * @brief Steps the simulation from t = 0 until config.tEnd on all threads of a pool.
+ *
+ * @param pool Pool whose threads share the work.
+ * @param grid Initialized grid; holds the final fields on return.
+ * @param bounds Row boundaries with one band per pool thread.
+ * @param checksums Receives a checksum of the field at step 0, every
+ *                  checksumEvery steps and at the end, or nullptr.
+ * @param checksumEvery Number of steps between checksums.
+ * @return Number of steps taken.
+ */
+long runPoolSimulation(ThreadPool& pool, PoolGrid& grid, const std::vector<int>& bounds,
+                       std::vector<FieldChecksum>* checksums = nullptr, int checksumEvery = 10);
+
+/**
+ * @brief Returns the sum of U^2 over the grid.
+ */
+double poolFieldEnergy(const PoolGrid& grid);
+
+#endif // POOL_SOLVER_H
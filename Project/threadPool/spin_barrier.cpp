@@ -0,0 +1,73 @@
+/**
+ * @file spin_barrier.cpp
+ * @brief Implementation of the barrier declared in spin_barrier.h.
+ */
+
+#include "spin_barrier.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#ifdef WAVE_STD_BARRIER
+
+SpinBarrier::SpinBarrier(int threads, int) : barrier(threads) {}
+
+void SpinBarrier::arriveAndWait() {
+    barrier.arrive_and_wait();
+}
+
+long long SpinBarrier::fallbacks() const {
+    return 0;
+}
+
+#else
+
+/**
+ * @brief Tells the core that the thread is spinning, freeing resources for its sibling.
+ */
+static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif
+}
+
+SpinBarrier::SpinBarrier(int threads, int spinBudget)
+    : threads(threads), spinBudget(spinBudget), remaining(threads), sense(0), sleepers(0), blocked(0) {}
+
+void SpinBarrier::arriveAndWait() {
+    // The sense cannot flip before this thread has arrived
+    const int phase = sense.load(std::memory_order_acquire);
+
+    if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        // Last to arrive: reset the count for the next phase, then release everyone
+        remaining.store(threads, std::memory_order_relaxed);
+        sense.store(1 - phase, std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_seq_cst) > 0) {
+            sense.notify_all();
+        }
+        return;
+    }
+
+    for (int spin = 0; spin < spinBudget; ++spin) {
+        if (sense.load(std::memory_order_acquire) != phase) {
+            return;
+        }
+        cpuRelax();
+    }
+
+    // Registering before the last check means the last thread either sees a
+    // sleeper and wakes it, or the sleeper sees the flipped sense
+    blocked.fetch_add(1, std::memory_order_relaxed);
+    sleepers.fetch_add(1, std::memory_order_seq_cst);
+    while (sense.load(std::memory_order_seq_cst) == phase) {
+        sense.wait(phase, std::memory_order_seq_cst);
+    }
+    sleepers.fetch_sub(1, std::memory_order_relaxed);
+}
+
+long long SpinBarrier::fallbacks() const {
+    return blocked.load(std::memory_order_relaxed);
+}
+
+#endif
@@ -0,0 +1,60 @@
+/**
+ * @file spin_barrier.h
+ * @brief Sense-reversing barrier that spins before it blocks.
+ *
+ * A step of a small grid takes only microseconds, less than waking a thread
+ * that sleeps in the kernel. Threads arriving at the barrier therefore first
+ * spin on a shared sense flag, which the last thread flips, and only block on
+ * it with a futex wait (std::atomic::wait) once their spin budget is used up.
+ * The last thread only issues the wake-up call if some thread is blocked.
+ *
+ * Built with WAVE_STD_BARRIER (make BARRIER=std) the barrier is a plain
+ * std::barrier instead, for comparison.
+ */
+#ifndef SPIN_BARRIER_H
+#define SPIN_BARRIER_H
+
+#include <atomic>
+
+#ifdef WAVE_STD_BARRIER
+#include <barrier>
+#endif
+
+class SpinBarrier {
+public:
+    /**
+     * @brief Creates a barrier.
+     *
+     * @param threads Number of threads that arrive in every phase.
+     * @param spinBudget Polls of the sense flag before a thread blocks.
+     */
+    SpinBarrier(int threads, int spinBudget);
+
+    SpinBarrier(const SpinBarrier&) = delete;
+    SpinBarrier& operator=(const SpinBarrier&) = delete;
+
+    /**
+     * @brief Waits until all threads have arrived.
+     */
+    void arriveAndWait();
+
+    /**
+     * @brief Returns how often a thread ran out of spins and blocked.
+     */
+    long long fallbacks() const;
+
+private:
+#ifdef WAVE_STD_BARRIER
+    std::barrier<> barrier;
+#else
+    const int threads;
+    const int spinBudget;
+    // Written by every arrival; kept off the cache line of the flag the waiters poll
+    alignas(64) std::atomic<int> remaining;
+    alignas(64) std::atomic<int> sense;
+    alignas(64) std::atomic<int> sleepers;
+    std::atomic<long long> blocked;
+#endif
+};
+
+#endif // SPIN_BARRIER_H
@@ -0,0 +1,84 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Implementation of the thread pool declared in thread_pool.h.
+ */
+
+#include "thread_pool.h"
+#include <pthread.h>
+
+/**
+ * @brief Pins a thread to one CPU.
+ */
+static void pinThread(pthread_t thread, int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(thread, sizeof(set), &set);
+}
+
+ThreadPool::ThreadPool(int threads, int spinBudget, bool pin)
+    : threads(threads), pinned(pin), dispatch(threads, spinBudget), steps(threads, spinBudget),
+      task(nullptr), stopping(false) {
+    // Thread k runs on the k-th allowed CPU, wrapping around if there are fewer
+    CPU_ZERO(&callerAffinity);
+    sched_getaffinity(0, sizeof(callerAffinity), &callerAffinity);
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &callerAffinity)) {
+            cpus.push_back(cpu);
+        }
+    }
+    pinned = pinned && !cpus.empty();
+
+    if (pinned) {
+        pinThread(pthread_self(), cpus[0]);
+    }
+    for (int k = 1; k < threads; ++k) {
+        workers.emplace_back(&ThreadPool::work, this, k);
+        if (pinned) {
+            pinThread(workers.back().native_handle(), cpus[k % cpus.size()]);
+        }
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    stopping = true;
+    dispatch.arriveAndWait();
+    for (size_t k = 0; k < workers.size(); ++k) {
+        workers[k].join();
+    }
+    if (pinned) {
+        pthread_setaffinity_np(pthread_self(), sizeof(callerAffinity), &callerAffinity);
+    }
+}
+
+int ThreadPool::size() const {
+    return threads;
+}
+
+void ThreadPool::run(const std::function<void(int)>& job) {
+    // The barriers order the writes of task before and the work of all threads after
+    task = &job;
+    dispatch.arriveAndWait();
+    job(0);
+    dispatch.arriveAndWait();
+    task = nullptr;
+}
+
+void ThreadPool::barrier() {
+    steps.arriveAndWait();
+}
+
+long long ThreadPool::barrierFallbacks() const {
+    return steps.fallbacks();
+}
+
+void ThreadPool::work(int thread) {
+    while (true) {
+        dispatch.arriveAndWait();
+        if (stopping) {
+            return;
+        }
+        (*task)(thread);
+        dispatch.arriveAndWait();
+    }
+}
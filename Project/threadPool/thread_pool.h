@@ -0,0 +1,74 @@
+/**
+ * @file thread_pool.h
+ * @brief Persistent pool of threads pinned to cores that run one task together.
+ *
+ * Instead of forking and joining threads for every parallel loop, the pool
+ * starts its threads once and hands all of them the same task, which runs the
+ * whole time loop and synchronises the steps with barrier(). Between tasks
+ * the workers wait on a separate barrier and fall asleep after the spin budget.
+ */
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <functional>
+#include <thread>
+#include <vector>
+#include <sched.h>
+#include "spin_barrier.h"
+
+class ThreadPool {
+public:
+    /**
+     * @brief Starts the worker threads.
+     *
+     * @param threads Number of threads including the calling one, which is thread 0.
+     * @param spinBudget Polls of a barrier before a thread blocks.
+     * @param pin Pin thread k to the k-th CPU the process may run on.
+     */
+    ThreadPool(int threads, int spinBudget, bool pin);
+
+    /**
+     * @brief Stops and joins the workers and restores the affinity of the calling thread.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Returns the number of threads including the calling one.
+     */
+    int size() const;
+
+    /**
+     * @brief Runs task(thread) on every thread and returns when all have finished.
+     *
+     * @param task Task to run; the calling thread runs task(0).
+     */
+    void run(const std::function<void(int)>& task);
+
+    /**
+     * @brief Waits for all threads of the running task; only call from within a task.
+     */
+    void barrier();
+
+    /**
+     * @brief Returns how often a thread blocked in barrier() after spinning.
+     */
+    long long barrierFallbacks() const;
+
+private:
+    void work(int thread);
+
+    int threads;
+    bool pinned;
+    cpu_set_t callerAffinity;
+    std::vector<int> cpus;
+    std::vector<std::thread> workers;
+    SpinBarrier dispatch;
+    SpinBarrier steps;
+    const std::function<void(int)>* task;
+    bool stopping;
+};
+
+#endif // THREAD_POOL_H
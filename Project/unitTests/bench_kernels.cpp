@@ -0,0 +1,222 @@
+/**
+ * @file bench_kernels.cpp
+ * @brief Micro-benchmarks of the solver kernels with a per-machine regression gate.
+ *
+ * Measures the throughput of updateLaplacian() and applyBoundaryConditions()
+ * at several grid sizes as cells per second, taking the best of several
+ * batches to filter out interference. The results are compared with a
+ * baseline file recorded earlier on the same machine, and the program fails
+ * if any kernel got slower than the tolerance allows. A kernel that looks
+ * slower is measured again, up to three rounds in all, so a busy moment of a
+ * shared node is not reported as a regression. Without a baseline the results
+ * are recorded as the new one.
+ *
+ * Usage: bench_kernels.out --baseline <file> [--tolerance <fraction>] [--update]
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "simulation.h"
+
+/**
+ * @brief Throughput of one kernel at one grid size.
+ */
+struct Benchmark {
+    std::string kernel;
+    int n;
+    double rate; /**< Cells per second */
+};
+
+typedef std::map<std::pair<std::string, int>, double> Baseline;
+
+/**
+ * @brief Returns the best throughput of a kernel over several timed batches.
+ *
+ * The batch size is first doubled until a batch takes at least 20 ms, so the
+ * timer resolution does not matter.
+ *
+ * @param kernel Kernel to run once.
+ * @param cells Cells processed by one run.
+ */
+template <typename Kernel>
+static double bestRate(Kernel kernel, double cells) {
+    typedef std::chrono::steady_clock Clock;
+    long repetitions = 1;
+    double seconds = 0.0;
+    while (true) {
+        Clock::time_point start = Clock::now();
+        for (long r = 0; r < repetitions; ++r) {
+            kernel();
+        }
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (seconds >= 0.02) {
+            break;
+        }
+        repetitions *= 2;
+    }
+
+    double best = seconds;
+    for (int batch = 0; batch < 7; ++batch) {
+        Clock::time_point start = Clock::now();
+        for (long r = 0; r < repetitions; ++r) {
+            kernel();
+        }
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    return cells * repetitions / best;
+}
+
+/**
+ * @brief Measures both kernels on the default geometry at grid size n.
+ */
+static void benchmarkSize(int n, std::vector<Benchmark>& results) {
+    SimulationConfig config = defaultConfig();
+    config.N = n;
+    std::vector<double> xlin(n);
+    std::vector<std::vector<double>> U(n, std::vector<double>(n, 0.0));
+    std::vector<std::vector<bool>> mask(n, std::vector<bool>(n, false));
+    initializeGrid(U, mask, xlin, config);
+
+    // A smooth field without zeros, so no kernel runs on a trivial input
+    std::vector<std::vector<double>> Uprev = U;
+    std::vector<std::vector<double>> Unew = U;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            U[i][j] = 1.0 + std::sin(0.1 * i) * std::cos(0.1 * j);
+            Uprev[i][j] = 0.99 * U[i][j];
+        }
+    }
+
+    double fac = 0.5;
+    double interior = static_cast<double>(n - 2) * (n - 2);
+    Benchmark laplacian = { "updateLaplacian", n, bestRate([&] {
+        updateLaplacian(U, Uprev, Unew, mask, fac);
+    }, interior) };
+    results.push_back(laplacian);
+
+    double t = 0.0;
+    double boundary = 4.0 * n;
+    Benchmark conditions = { "applyBoundaryConditions", n, bestRate([&] {
+        applyBoundaryConditions(Unew, mask, t, xlin, config.frequency);
+        t += 1e-4;
+    }, boundary) };
+    results.push_back(conditions);
+}
+
+/**
+ * @brief Reads a baseline file; lines hold kernel, grid size and cells per second.
+ */
+static bool readBaseline(const std::string& path, Baseline& baseline) {
+    std::ifstream in(path.c_str());
+    if (!in) {
+        return false;
+    }
+    std::string kernel;
+    int n;
+    double rate;
+    while (in >> kernel >> n >> rate) {
+        baseline[std::make_pair(kernel, n)] = rate;
+    }
+    return true;
+}
+
+static bool writeBaseline(const std::string& path, const std::vector<Benchmark>& results) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    for (size_t k = 0; k < results.size(); ++k) {
+        std::fprintf(file, "%s %d %.6e\n", results[k].kernel.c_str(), results[k].n, results[k].rate);
+    }
+    return std::fclose(file) == 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::string baselinePath;
+    double tolerance = 0.3;
+    bool update = false;
+    for (int a = 1; a < argc; ++a) {
+        bool hasValue = a + 1 < argc;
+        if (std::strcmp(argv[a], "--update") == 0) {
+            update = true;
+        } else if (hasValue && std::strcmp(argv[a], "--baseline") == 0) {
+            baselinePath = argv[++a];
+        } else if (hasValue && std::strcmp(argv[a], "--tolerance") == 0) {
+            tolerance = std::atof(argv[++a]);
+        }
+    }
+    if (baselinePath.empty()) {
+        std::cerr << "Usage: " << argv[0] << " --baseline <file> [--tolerance <fraction>] [--update]" << std::endl;
+        return 1;
+    }
+
+    Baseline baseline;
+    bool haveBaseline = !update && readBaseline(baselinePath, baseline);
+
+    // Every round keeps the best rate of each kernel; further rounds only run
+    // while some kernel is below the tolerance
+    const int sizes[] = { 64, 256, 1024 };
+    std::vector<Benchmark> results;
+    for (int round = 0; round < 3; ++round) {
+        std::vector<Benchmark> measured;
+        for (int n : sizes) {
+            benchmarkSize(n, measured);
+        }
+
+        bool below = false;
+        for (size_t k = 0; k < measured.size(); ++k) {
+            if (round == 0) {
+                results.push_back(measured[k]);
+            } else {
+                results[k].rate = std::max(results[k].rate, measured[k].rate);
+            }
+            Baseline::const_iterator reference = baseline.find(std::make_pair(results[k].kernel, results[k].n));
+            below = below || (reference != baseline.end() && results[k].rate < (1.0 - tolerance) * reference->second);
+        }
+        if (!below) {
+            break;
+        }
+    }
+
+    bool regressed = false;
+    std::printf("%-24s %6s %14s %14s %8s\n", "kernel", "N", "Mcells/s", "baseline", "change");
+    for (size_t k = 0; k < results.size(); ++k) {
+        const Benchmark& b = results[k];
+        Baseline::const_iterator reference = baseline.find(std::make_pair(b.kernel, b.n));
+        if (reference == baseline.end()) {
+            std::printf("%-24s %6d %14.1f %14s %8s\n", b.kernel.c_str(), b.n, b.rate / 1e6, "-", "new");
+            continue;
+        }
+        double change = b.rate / reference->second - 1.0;
+        bool slower = change < -tolerance;
+        regressed = regressed || slower;
+        std::printf("%-24s %6d %14.1f %14.1f %+7.1f%%%s\n", b.kernel.c_str(), b.n, b.rate / 1e6,
+                    reference->second / 1e6, 100.0 * change, slower ? "  REGRESSION" : "");
+    }
+
+    if (!haveBaseline) {
+        if (!writeBaseline(baselinePath, results)) {
+            std::cerr << "Could not write " << baselinePath << std::endl;
+            return 1;
+        }
+        std::cout << "Recorded the baseline of this machine in " << baselinePath << std::endl;
+        return 0;
+    }
+    if (regressed) {
+        std::cout << "Throughput dropped by more than " << 100.0 * tolerance << "% against " << baselinePath
+                  << std::endl;
+        return 1;
+    }
+    std::cout << "No kernel dropped by more than " << 100.0 * tolerance << "% against " << baselinePath << std::endl;
+    return 0;
+}
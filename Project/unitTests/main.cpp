@@ -19,7 +19,7 @@ int main() {
     double t = 0.0;
 
     while (t < tEnd) {
-        updateLaplacian(U, Unew, mask, fac);
+        updateLaplacian(U, Uprev, Unew, mask, fac);
 
         Uprev = U;
         U = Unew;
@@ -16,60 +16,241 @@ const int N = 256;
 const double boxsize = 1.0;
 const double c = 1.0;
 const double tEnd = 2.0;
+const int solverVersion = 3;
+
+SimulationConfig defaultConfig() {
+    SimulationConfig config;
+    config.N = N;
+    config.boxsize = boxsize;
+    config.c = c;
+    config.tEnd = tEnd;
+    config.frequency = 10.0;
+    config.slitWidth = 1.0 / 16;
+    config.slitSpacing = 5.0 / 16;
+    config.screen = 7.0 / 8;
+    return config;
+}
+
+/**
+ * @brief Converts a fraction of the box into a grid index, rounding down.
+ */
+static int gridIndex(double fraction, int n) {
+    return static_cast<int>(std::floor(fraction * n + 1e-9));
+}
 
 void initializeGrid(std::vector<std::vector<double>>& U, std::vector<std::vector<bool>>& mask, std::vector<double>& xlin) {
-    double dx = boxsize / N;
-    for (int i = 0; i < N; ++i) {
+    initializeGrid(U, mask, xlin, defaultConfig());
+}
+
+void initializeGrid(std::vector<std::vector<double>>& U, std::vector<std::vector<bool>>& mask, std::vector<double>& xlin, const SimulationConfig& config) {
+    const int n = config.N;
+    double dx = config.boxsize / n;
+    for (int i = 0; i < n; ++i) {
         xlin[i] = 0.5 * dx + i * dx;
     }
 
-    for (int i = 0; i < N; ++i) {
+    for (int i = 0; i < n; ++i) {
         mask[0][i] = true;
-        mask[N-1][i] = true;
+        mask[n-1][i] = true;
         mask[i][0] = true;
-        mask[i][N-1] = true;
+        mask[i][n-1] = true;
     }
 
-    for (int i = N/4; i < 9*N/32; ++i) {
-        for (int j = 0; j < N-1; ++j) {
+    for (int i = n/4; i < 9*n/32; ++i) {
+        for (int j = 0; j < n-1; ++j) {
             mask[i][j] = true;
         }
     }
 
-    for (int i = 1; i < N-1; ++i) {
-        for (int j = 5*N/16; j < 3*N/8; ++j) {
+    // Two slits placed symmetrically about the centre line
+    double left = 0.5 - 0.5 * config.slitSpacing;
+    double right = 0.5 + 0.5 * config.slitSpacing;
+    double half = 0.5 * config.slitWidth;
+    for (int i = 1; i < n-1; ++i) {
+        for (int j = gridIndex(left - half, n); j < gridIndex(left + half, n); ++j) {
             mask[i][j] = false;
         }
-        for (int j = 5*N/8; j < 11*N/16; ++j) {
+        for (int j = gridIndex(right - half, n); j < gridIndex(right + half, n); ++j) {
             mask[i][j] = false;
         }
     }
 }
 
 void applyBoundaryConditions(std::vector<std::vector<double>>& U, const std::vector<std::vector<bool>>& mask, double t, const std::vector<double>& xlin) {
-    for (int i = 0; i < N; ++i) {
-        if (mask[i][0] || mask[i][N-1] || mask[0][i] || mask[N-1][i]) {
-            U[i][0] = U[i][N-1] = U[0][i] = U[N-1][i] = 0.0;
+    applyBoundaryConditions(U, mask, t, xlin, 10.0);
+}
+
+void applyBoundaryConditions(std::vector<std::vector<double>>& U, const std::vector<std::vector<bool>>& mask, double t, const std::vector<double>& xlin, double frequency) {
+    // Mirrored simulations store fewer columns than rows
+    const int rows = static_cast<int>(U.size());
+    const int cols = static_cast<int>(U[0].size());
+    for (int i = 0; i < rows; ++i) {
+        if (mask[i][0] || mask[i][cols-1]) {
+            U[i][0] = U[i][cols-1] = 0.0;
+        }
+    }
+    for (int j = 0; j < cols; ++j) {
+        if (mask[0][j] || mask[rows-1][j]) {
+            U[0][j] = U[rows-1][j] = 0.0;
         }
     }
 
-    for (int i = 0; i < N; ++i) {
-        U[0][i] = std::sin(20.0 * M_PI * t) * std::pow(std::sin(M_PI * xlin[i]), 2);
+    for (int j = 0; j < cols; ++j) {
+        U[0][j] = std::sin(2.0 * frequency * M_PI * t) * std::pow(std::sin(M_PI * xlin[j]), 2);
     }
 }
 
-void updateLaplacian(const std::vector<std::vector<double>>& U, std::vector<std::vector<double>>& Unew, const std::vector<std::vector<bool>>& mask, double fac) {
-    for (int i = 1; i < N-1; ++i) {
-        for (int j = 1; j < N-1; ++j) {
+void updateLaplacian(const std::vector<std::vector<double>>& U, const std::vector<std::vector<double>>& Uprev, std::vector<std::vector<double>>& Unew, const std::vector<std::vector<bool>>& mask, double fac) {
+    const int rows = static_cast<int>(U.size());
+    const int cols = static_cast<int>(U[0].size());
+    for (int i = 1; i < rows-1; ++i) {
+        for (int j = 1; j < cols-1; ++j) {
             if (!mask[i][j]) {
                 double ULX = U[i-1][j];
                 double URX = U[i+1][j];
                 double ULY = U[i][j-1];
                 double URY = U[i][j+1];
                 double laplacian = (ULX + URX + ULY + URY - 4.0 * U[i][j]);
-                Unew[i][j] = 2.0 * U[i][j] - U[i][j] + fac * laplacian;
+                Unew[i][j] = 2.0 * U[i][j] - Uprev[i][j] + fac * laplacian;
             }
         }
     }
 }
 
+
+bool isMirrorSymmetric(const std::vector<std::vector<bool>>& mask) {
+    for (size_t i = 0; i < mask.size(); ++i) {
+        const size_t n = mask[i].size();
+        for (size_t j = 0; j < n / 2; ++j) {
+            if (mask[i][j] != mask[i][n-1-j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool isInflowSymmetric(const std::vector<double>& xlin) {
+    // sin^2(pi x) is only symmetric about the centre of the box if the box
+    // holds a whole number of its periods
+    const size_t n = xlin.size();
+    for (size_t j = 0; j < n / 2; ++j) {
+        double left = std::pow(std::sin(M_PI * xlin[j]), 2);
+        double right = std::pow(std::sin(M_PI * xlin[n-1-j]), 2);
+        if (std::fabs(left - right) > 1e-12) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the number of stored columns of a mirrored n x n domain.
+ *
+ * The columns up to and including the centre are simulated; the last one
+ * reflects the column mirrored to it.
+ */
+static int mirroredColumns(int n) {
+    return (n + 1) / 2 + 1;
+}
+
+int storedColumn(int j, int n, int cols) {
+    return cols == n || j < cols - 1 ? j : n - 1 - j;
+}
+
+/**
+ * @brief Copies the column mirrored to the reflecting column of a mirrored grid.
+ */
+static void reflectMirrorColumn(std::vector<std::vector<double>>& U, int n) {
+    const int last = static_cast<int>(U[0].size()) - 1;
+    for (size_t i = 0; i < U.size(); ++i) {
+        U[i][last] = U[i][n - 1 - last];
+    }
+}
+
+void initializeSimulation(Simulation& sim, const SimulationConfig& config, bool useSymmetry) {
+    const int n = config.N;
+    sim.config = config;
+    sim.xlin.assign(n, 0.0);
+    sim.mask.assign(n, std::vector<bool>(n, false));
+    sim.screen.assign(n, 0.0);
+
+    // initializeGrid() only sets the mask and coordinates, so the fields can be sized after
+    // the symmetry is known
+    initializeGrid(sim.U, sim.mask, sim.xlin, config);
+    sim.mirrored = useSymmetry && isMirrorSymmetric(sim.mask) && isInflowSymmetric(sim.xlin);
+
+    const int cols = sim.mirrored ? mirroredColumns(n) : n;
+    if (sim.mirrored) {
+        for (int i = 0; i < n; ++i) {
+            std::vector<bool>(sim.mask[i].begin(), sim.mask[i].begin() + cols).swap(sim.mask[i]);
+        }
+    }
+    sim.U.assign(n, std::vector<double>(cols, 0.0));
+    sim.Uprev.assign(n, std::vector<double>(cols, 0.0));
+    sim.Unew.assign(n, std::vector<double>(cols, 0.0));
+
+    double dx = config.boxsize / n;
+    sim.dt = (std::sqrt(2)/2) * dx / config.c;
+    sim.fac = sim.dt*sim.dt * config.c*config.c / (dx*dx);
+    sim.t = 0.0;
+}
+
+std::vector<std::vector<double>> fullField(const Simulation& sim) {
+    const int n = sim.config.N;
+    const int cols = static_cast<int>(sim.U[0].size());
+    std::vector<std::vector<double>> field(n, std::vector<double>(n));
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            field[i][j] = sim.U[i][storedColumn(j, n, cols)];
+        }
+    }
+    return field;
+}
+
+double fieldEnergy(const Simulation& sim) {
+    const int n = sim.config.N;
+    const int cols = static_cast<int>(sim.U[0].size());
+    double energy = 0.0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            double u = sim.U[i][storedColumn(j, n, cols)];
+            energy += u * u;
+        }
+    }
+    return energy;
+}
+
+void stepSimulation(Simulation& sim) {
+    const int n = sim.config.N;
+    const int cols = static_cast<int>(sim.U[0].size());
+    updateLaplacian(sim.U, sim.Uprev, sim.Unew, sim.mask, sim.fac);
+
+    // Masked cells are never updated: the barrier stays zero in all grids
+    // and the outer boundary is reset below. Unew keeps the oldest field as
+    // scratch for the next step.
+    sim.Uprev.swap(sim.U);
+    sim.U.swap(sim.Unew);
+
+    applyBoundaryConditions(sim.U, sim.mask, sim.t, sim.xlin, sim.config.frequency);
+    if (sim.mirrored) {
+        reflectMirrorColumn(sim.U, n);
+    }
+
+    const std::vector<double>& row = sim.U[gridIndex(sim.config.screen, n)];
+    for (int j = 0; j < n; ++j) {
+        double u = row[storedColumn(j, n, cols)];
+        sim.screen[j] += u * u * sim.dt;
+    }
+
+    sim.t += sim.dt;
+}
+
+std::vector<double> runSimulation(const SimulationConfig& config, bool useSymmetry) {
+    Simulation sim;
+    initializeSimulation(sim, config, useSymmetry);
+    while (sim.t < config.tEnd) {
+        stepSimulation(sim);
+    }
+    return sim.screen;
+}
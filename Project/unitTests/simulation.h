@@ -6,6 +6,10 @@
  * a partial differential equation using finite difference methods. It also
  * declares functions related to initializing the grid, applying boundary
  * conditions, and updating the Laplacian.
+ *
+ * The constants below describe the default problem. SimulationConfig and the
+ * functions taking it allow other grid sizes, geometries and sources, which
+ * is what the parameter sweep uses.
  */
 #ifndef SIMULATION_H
 #define SIMULATION_H
@@ -18,6 +22,57 @@ extern const double boxsize;
 extern const double c;
 extern const double tEnd;
 
+/**
+ * @brief Version of the solver's numerics; increment whenever results change.
+ *
+ * Cached results are keyed by it, so old results are not reused after a change.
+ */
+extern const int solverVersion;
+
+/**
+ * @brief Physical and numerical parameters of one simulation.
+ *
+ * Lengths of the geometry are fractions of the box size.
+ */
+struct SimulationConfig {
+    int N;              /**< Grid size */
+    double boxsize;     /**< Size of the computational domain */
+    double c;           /**< Speed of propagation */
+    double tEnd;        /**< End time of simulation */
+    double frequency;   /**< Frequency of the inflow source */
+    double slitWidth;   /**< Width of each slit */
+    double slitSpacing; /**< Distance between the slit centres */
+    double screen;      /**< Position of the detector screen along the rows */
+};
+
+/**
+ * @brief Returns the configuration of the default problem.
+ */
+SimulationConfig defaultConfig();
+
+/**
+ * @brief State of a running simulation.
+ *
+ * If the geometry and the inflow profile are mirror symmetric about the
+ * centre column, only the left half of the columns is stored, followed by one
+ * column that reflects the column mirrored to it, which reproduces the full
+ * domain while halving memory and work. The inflow is only symmetric for a
+ * whole-numbered boxsize.
+ */
+struct Simulation {
+    SimulationConfig config;
+    std::vector<double> xlin;
+    std::vector<std::vector<double>> U;
+    std::vector<std::vector<double>> Uprev;
+    std::vector<std::vector<double>> Unew;
+    std::vector<std::vector<bool>> mask;
+    std::vector<double> screen; /**< Time-integrated intensity U^2 along the screen row */
+    double dt;
+    double fac;
+    double t;
+    bool mirrored;              /**< Only the left half of the columns is simulated */
+};
+
 /**
  * @brief Initializes the grid and boundary conditions.
  * 
@@ -27,6 +82,16 @@ extern const double tEnd;
  */
 void initializeGrid(std::vector<std::vector<double>>& U, std::vector<std::vector<bool>>& mask, std::vector<double>& xlin);
 
+/**
+ * @brief Initializes the grid of an arbitrary configuration.
+ *
+ * @param U Grid values, config.N x config.N.
+ * @param mask Grid mask, config.N x config.N.
+ * @param xlin Vector storing the spatial coordinates.
+ * @param config Simulation parameters.
+ */
+void initializeGrid(std::vector<std::vector<double>>& U, std::vector<std::vector<bool>>& mask, std::vector<double>& xlin, const SimulationConfig& config);
+
 /**
  * @brief Applies boundary conditions to the grid.
  * 
@@ -37,15 +102,94 @@ void initializeGrid(std::vector<std::vector<double>>& U, std::vector<std::vector
  */
 void applyBoundaryConditions(std::vector<std::vector<double>>& U, const std::vector<std::vector<bool>>& mask, double t, const std::vector<double>& xlin);
 
+/**
+ * @brief Applies boundary conditions with a given source frequency.
+ *
+ * @param U Grid values.
+ * @param mask Grid mask.
+ * @param t Current time.
+ * @param xlin Vector storing the spatial coordinates.
+ * @param frequency Frequency of the inflow source.
+ */
+void applyBoundaryConditions(std::vector<std::vector<double>>& U, const std::vector<std::vector<bool>>& mask, double t, const std::vector<double>& xlin, double frequency);
+
 /**
  * @brief Updates the Laplacian of the grid.
- * 
+ *
+ * Leapfrog step Unew = 2 U - Uprev + fac * laplacian(U) of the cells that are
+ * not masked. This is the reference every other backend must reproduce bit for bit.
+ *
  * @param U Current grid values.
- * @param Unew New grid values after Laplacian calculation.
+ * @param Uprev Grid values one step earlier.
+ * @param Unew New grid values after Laplacian calculation; may not alias U or Uprev.
  * @param mask Grid mask.
  * @param fac Factor used in the numerical approximation.
  */
-void updateLaplacian(const std::vector<std::vector<double>>& U, std::vector<std::vector<double>>& Unew, const std::vector<std::vector<bool>>& mask, double fac);
+void updateLaplacian(const std::vector<std::vector<double>>& U, const std::vector<std::vector<double>>& Uprev, std::vector<std::vector<double>>& Unew, const std::vector<std::vector<bool>>& mask, double fac);
+
+/**
+ * @brief Checks whether a mask is mirror symmetric about its centre column.
+ *
+ * @param mask Grid mask.
+ */
+bool isMirrorSymmetric(const std::vector<std::vector<bool>>& mask);
+
+/**
+ * @brief Checks whether the inflow profile sin^2(pi x) is mirror symmetric about the centre column.
+ *
+ * @param xlin Spatial coordinates of the columns.
+ */
+bool isInflowSymmetric(const std::vector<double>& xlin);
+
+/**
+ * @brief Allocates and initializes a simulation.
+ *
+ * @param sim Simulation to initialize.
+ * @param config Simulation parameters.
+ * @param useSymmetry Simulate half the columns if the geometry is mirror symmetric.
+ */
+void initializeSimulation(Simulation& sim, const SimulationConfig& config, bool useSymmetry = true);
+
+/**
+ * @brief Returns the stored column that holds column j of the full domain.
+ *
+ * @param j Column of the full domain.
+ * @param n Columns of the full domain.
+ * @param cols Stored columns; equal to n unless the simulation is mirrored.
+ */
+int storedColumn(int j, int n, int cols);
+
+/**
+ * @brief Returns the field of the full config.N x config.N domain.
+ *
+ * For a mirrored simulation the right half is reconstructed from the left.
+ *
+ * @param sim Simulation to read.
+ */
+std::vector<std::vector<double>> fullField(const Simulation& sim);
+
+/**
+ * @brief Returns the sum of U^2 over the full config.N x config.N domain.
+ *
+ * @param sim Simulation to read.
+ */
+double fieldEnergy(const Simulation& sim);
+
+/**
+ * @brief Advances a simulation by one time step and accumulates the screen intensity.
+ *
+ * @param sim Simulation to advance.
+ */
+void stepSimulation(Simulation& sim);
+
+/**
+ * @brief Runs a simulation until config.tEnd.
+ *
+ * @param config Simulation parameters.
+ * @param useSymmetry Simulate half the columns if the geometry is mirror symmetric.
+ * @return Time-integrated intensity along the detector screen.
+ */
+std::vector<double> runSimulation(const SimulationConfig& config, bool useSymmetry = true);
 
 #endif // SIMULATION_H
 
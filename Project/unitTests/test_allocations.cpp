@@ -0,0 +1,62 @@
+#include <iostream>
+#include <vector>
+#include "alloc_counter.h"
+#include "simulation.h"
+
+// Escapes the test so the compiler cannot elide the allocation
+std::vector<double>* escaped = nullptr;
+
+void test_allocationCounter() {
+    long long before = allocationCount();
+    escaped = new std::vector<double>(100);
+    bool passed = allocationCountingEnabled && allocationCount() == before + 2;
+    delete escaped;
+
+    std::cout << "test_allocationCounter: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_stepSimulationDoesNotAllocate() {
+    SimulationConfig config = defaultConfig();
+    config.N = 64;
+    Simulation sim;
+    initializeSimulation(sim, config);
+    stepSimulation(sim);
+
+    long long before = allocationCount();
+    for (int step = 0; step < 20; ++step) {
+        stepSimulation(sim);
+    }
+    bool passed = allocationCount() == before;
+
+    std::cout << "test_stepSimulationDoesNotAllocate: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_serialStepDoesNotAllocate() {
+    // The time loop of the serial solver, with copies between equally sized grids
+    std::vector<double> xlin(N);
+    std::vector<std::vector<double>> U(N, std::vector<double>(N, 0.0));
+    std::vector<std::vector<bool>> mask(N, std::vector<bool>(N, false));
+    std::vector<std::vector<double>> Uprev = U;
+    std::vector<std::vector<double>> Unew(N, std::vector<double>(N, 0.0));
+    initializeGrid(U, mask, xlin);
+
+    long long before = allocationCount();
+    double t = 0.0;
+    for (int step = 0; step < 20; ++step) {
+        updateLaplacian(U, Uprev, Unew, mask, 0.5);
+        Uprev = U;
+        U = Unew;
+        applyBoundaryConditions(U, mask, t, xlin);
+        t += 0.001;
+    }
+    bool passed = allocationCount() == before;
+
+    std::cout << "test_serialStepDoesNotAllocate: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_allocationCounter();
+    test_stepSimulationDoesNotAllocate();
+    test_serialStepDoesNotAllocate();
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "checksum.h"
+#include "simulation.h"
+
+static std::vector<std::vector<double>> makeField(int n) {
+    std::vector<std::vector<double>> U(n, std::vector<double>(n));
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            U[i][j] = std::sin(0.37 * i + 1.3 * j);
+        }
+    }
+    return U;
+}
+
+void test_checksumOrderIndependent() {
+    const int n = 16;
+    std::vector<std::vector<double>> U = makeField(n);
+    FieldChecksum whole = fieldChecksum(U, 5);
+
+    // Two "ranks" adding their rows backwards give the same hash
+    FieldChecksum lower = emptyChecksum(5);
+    FieldChecksum upper = emptyChecksum(5);
+    for (int i = n / 2 - 1; i >= 0; --i) {
+        addRow(lower, i, U[i].data(), n);
+    }
+    for (int i = n - 1; i >= n / 2; --i) {
+        addRow(upper, i, U[i].data(), n);
+    }
+    addChecksum(upper, lower);
+    bool passed = upper.hash == whole.hash && checksumsMatch(whole, upper, n, 1e-12);
+
+    // One ulp in one cell changes the hash, swapping two cells as well
+    std::vector<std::vector<double>> changed = U;
+    changed[3][4] = std::nextafter(changed[3][4], 2.0);
+    std::vector<std::vector<double>> swapped = U;
+    std::swap(swapped[2][1], swapped[1][2]);
+    passed = passed && fieldChecksum(changed, 5).hash != whole.hash && fieldChecksum(swapped, 5).hash != whole.hash
+          && checksumsMatch(whole, fieldChecksum(changed, 5), n, 1e-12);
+
+    // Walls may hold -0.0 in one backend and 0.0 in another
+    std::vector<std::vector<double>> zeros(n, std::vector<double>(n, 0.0));
+    std::vector<std::vector<double>> negativeZeros(n, std::vector<double>(n, -0.0));
+    passed = passed && fieldChecksum(zeros, 0).hash == fieldChecksum(negativeZeros, 0).hash;
+
+    std::cout << "test_checksumOrderIndependent: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_firstDivergence() {
+    const int n = 16;
+    std::vector<FieldChecksum> a;
+    std::vector<std::vector<double>> U = makeField(n);
+    for (int step = 0; step < 5; ++step) {
+        U[step][step] += 1.0;
+        a.push_back(fieldChecksum(U, 10 * step));
+    }
+
+    std::vector<FieldChecksum> b = a;
+    bool passed = firstDivergence(a, b, n, 0.0) == -1;
+    b[3].hash ^= 1;
+    passed = passed && firstDivergence(a, b, n, 0.0) == 3 && firstDivergence(a, b, n, 1e-12) == -1;
+    b[2].energy *= 1.0 + 1e-6;
+    passed = passed && firstDivergence(a, b, n, 1e-9) == 2 && firstDivergence(a, b, n, 1e-3) == -1;
+
+    // A run that stopped early diverges where it ends
+    std::vector<FieldChecksum> prefix(a.begin(), a.begin() + 2);
+    passed = passed && firstDivergence(a, prefix, n, 0.0) == 2;
+
+    std::cout << "test_firstDivergence: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_checksumFileRoundTrip() {
+    const char* path = "test_checksums.txt";
+    std::vector<FieldChecksum> written;
+    std::vector<std::vector<double>> U = makeField(8);
+    written.push_back(fieldChecksum(U, 0));
+    U[1][1] = -1e-300;
+    written.push_back(fieldChecksum(U, 7));
+
+    std::vector<FieldChecksum> read;
+    bool passed = writeChecksums(path, written) && readChecksums(path, read) && read.size() == written.size();
+    for (size_t k = 0; passed && k < read.size(); ++k) {
+        passed = read[k].step == written[k].step && read[k].hash == written[k].hash && read[k].sum == written[k].sum
+              && read[k].energy == written[k].energy;
+    }
+    std::remove(path);
+    passed = passed && !readChecksums("missing_checksums.txt", read);
+
+    std::cout << "test_checksumFileRoundTrip: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_mirroredChecksumWithinTolerance() {
+    // The half domain sums the stencil in another order near the centre, so
+    // it agrees with the full domain to rounding but not bit for bit
+    SimulationConfig config = defaultConfig();
+    config.N = 64;
+    config.tEnd = 1.0;
+    Simulation full, half;
+    initializeSimulation(full, config, false);
+    initializeSimulation(half, config, true);
+    std::vector<FieldChecksum> a, b;
+    for (int step = 1; full.t < config.tEnd; ++step) {
+        stepSimulation(full);
+        stepSimulation(half);
+        a.push_back(fieldChecksum(fullField(full), step));
+        b.push_back(fieldChecksum(fullField(half), step));
+    }
+    bool passed = half.mirrored && firstDivergence(a, b, config.N, 1e-9) == -1 && a.back().energy > 0.0;
+
+    std::cout << "test_mirroredChecksumWithinTolerance: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_checksumOrderIndependent();
+    test_firstDivergence();
+    test_checksumFileRoundTrip();
+    test_mirroredChecksumWithinTolerance();
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <iostream>
+#include <cstdio>
+#include <vector>
+#include "ensemble.h"
+
+static Problem defaultProblem() {
+    Problem problem = { 256, 1.0, 1.0, 2.0, 10.0, 0.05, 0.3 };
+    return problem;
+}
+
+// Writes a specification and reads it back
+static bool readSpecification(const char* text, std::vector<Problem>& members) {
+    const char* path = "test_ensemble.txt";
+    FILE* file = std::fopen(path, "w");
+    std::fputs(text, file);
+    std::fclose(file);
+    bool read = readEnsemble(path, defaultProblem(), members);
+    std::remove(path);
+    return read;
+}
+
+void test_readEnsemble() {
+    // Every combination, the last parameter varying fastest; the rest keep their default
+    std::vector<Problem> members;
+    bool passed = readSpecification("# N and c\nN 64 128\n\nc 0.5 1 2  # speeds\n", members)
+               && members.size() == 6;
+    for (size_t m = 0; passed && m < members.size(); ++m) {
+        const double speeds[3] = { 0.5, 1.0, 2.0 };
+        passed = members[m].N == (m < 3 ? 64 : 128) && members[m].c == speeds[m % 3]
+              && members[m].tEnd == 2.0 && members[m].frequency == 10.0;
+    }
+
+    // An empty specification is the default problem
+    passed = passed && readSpecification("# nothing\n", members) && members.size() == 1 && members[0].N == 256;
+
+    std::cout << "test_readEnsemble: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_readEnsembleRejects() {
+    std::vector<Problem> members;
+    bool passed = !readSpecification("N 64\ntEnd\n", members)
+               && !readSpecification("N 64 # tEnd 1\nwavelength 2\n", members)
+               && !readSpecification("N 64 x\n", members)
+               && !readEnsemble("does_not_exist.txt", defaultProblem(), members);
+
+    std::cout << "test_readEnsembleRejects: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_ensembleGroup() {
+    // Contiguous groups that cover all ranks and differ in size by at most one
+    bool passed = true;
+    for (int size = 1; size <= 12; ++size) {
+        for (int groups = 1; groups <= size; ++groups) {
+            std::vector<int> count(groups, 0);
+            int previous = 0;
+            for (int rank = 0; rank < size; ++rank) {
+                int group = ensembleGroup(rank, size, groups);
+                passed = passed && group >= previous && group <= previous + 1 && group < groups;
+                previous = group;
+                ++count[group];
+            }
+            for (int g = 0; g < groups; ++g) {
+                passed = passed && (count[g] == size / groups || count[g] == size / groups + 1);
+            }
+        }
+    }
+    passed = passed && ensembleGroup(2, 10, 3) == 0 && ensembleGroup(3, 10, 3) == 1 && ensembleGroup(9, 10, 3) == 2;
+
+    std::cout << "test_ensembleGroup: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_readEnsemble();
+    test_readEnsembleRejects();
+    test_ensembleGroup();
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include "far_field.h"
+#include "fft.h"
+
+void test_fftMatchesDft() {
+    const size_t n = 64;
+    const double pi = std::acos(-1.0);
+    std::vector<std::complex<double>> data(n);
+    for (size_t j = 0; j < n; ++j) {
+        data[j] = std::complex<double>(std::sin(0.3 * j) + (j % 5), std::cos(0.7 * j));
+    }
+    std::vector<std::complex<double>> transform = data;
+    fft(transform);
+
+    double maxError = 0.0;
+    for (size_t k = 0; k < n; ++k) {
+        std::complex<double> sum(0.0, 0.0);
+        for (size_t j = 0; j < n; ++j) {
+            sum += data[j] * std::polar(1.0, -2.0 * pi * j * k / n);
+        }
+        maxError = std::max(maxError, std::abs(sum - transform[k]));
+    }
+    bool passed = maxError < 1e-9 && nextPowerOfTwo(64) == 64 && nextPowerOfTwo(65) == 128;
+    std::cout << "test_fftMatchesDft: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_farFieldSymmetric() {
+    // The slits are centred, so the pattern is symmetric with its maximum in the middle
+    SimulationConfig config = defaultConfig();
+    std::vector<double> screen = farFieldScreen(config);
+    int n = static_cast<int>(screen.size());
+
+    int peak = 0;
+    double asymmetry = 0.0;
+    for (int j = 0; j < n; ++j) {
+        if (screen[j] > screen[peak]) {
+            peak = j;
+        }
+        asymmetry = std::max(asymmetry, std::fabs(screen[j] - screen[n - 1 - j]));
+    }
+    ProfileComparison self = compareProfiles(screen, screen);
+    bool passed = n == config.N && std::fabs(screen[peak] - 1.0) < 1e-12 && std::abs(peak - n / 2) <= 1
+               && asymmetry < 1e-2 && self.correlation > 0.999 && self.rmsError < 1e-12 && self.peakShift == 0;
+    std::cout << "test_farFieldSymmetric: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_fftMatchesDft();
+    test_farFieldSymmetric();
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "geometry.h"
+#include "simulation.h"
+
+void test_slitGeometryMatchesReference() {
+    bool passed = true;
+    const int sizes[] = { 64, 100, 256 };
+    for (int n : sizes) {
+        SimulationConfig config = defaultConfig();
+        config.N = n;
+        std::vector<std::vector<double>> unused;
+        std::vector<std::vector<bool>> expected(n, std::vector<bool>(n, false));
+        std::vector<double> xlin(n);
+        initializeGrid(unused, expected, xlin, config);
+
+        std::vector<bool> mask(static_cast<size_t>(n) * n);
+        rasterizeRows(slitGeometry(config.slitWidth, config.slitSpacing), n, 0, n, mask);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                passed = passed && mask[static_cast<size_t>(i) * n + j] == expected[i][j];
+            }
+        }
+    }
+
+    std::cout << "test_slitGeometryMatchesReference: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_geometryRowsRasterizeIndependently() {
+    // A 10 x 8 bitmap whose rows 4 and 5 are dark
+    const char* bitmapPath = "test_geometry.pgm";
+    FILE* file = std::fopen(bitmapPath, "wb");
+    std::fprintf(file, "P5\n# barrier\n10 8\n255\n");
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 10; ++x) {
+            std::fputc(y == 4 || y == 5 ? 0 : 255, file);
+        }
+    }
+    std::fclose(file);
+
+    const std::string text =
+        "bitmap test_geometry.pgm\n"
+        "# comment line\n"
+        "open rectangle 0.4 0.5 0.6 0.75\n"
+        "wall circle 0.5 0.25 0.1   # scatterer\n"
+        "wall polygon 0.1 0.8 0.3 0.8 0.2 0.95\n";
+    Geometry geometry;
+    std::string error;
+    bool passed = parseGeometry(text, ".", geometry, error) && geometry.shapes.size() == 4;
+
+    // The whole domain at once and in bands of 7 rows at an offset
+    const int n = 80;
+    std::vector<bool> whole(static_cast<size_t>(n) * n);
+    std::vector<bool> bands(static_cast<size_t>(n + 3) * n, false);
+    if (passed) {
+        rasterizeRows(geometry, n, 0, n, whole);
+        for (int first = 0; first < n; first += 7) {
+            rasterizeRows(geometry, n, first, std::min(7, n - first), bands, static_cast<size_t>(first + 3) * n);
+        }
+    }
+    for (int i = 0; passed && i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            passed = passed && whole[static_cast<size_t>(i) * n + j] == bands[static_cast<size_t>(i + 3) * n + j];
+        }
+    }
+    auto wall = [&](double x, double y) { return whole[static_cast<size_t>(y * n) * n + static_cast<size_t>(x * n)]; };
+    passed = passed && wall(0.2, 0.55) && !wall(0.5, 0.55) && !wall(0.2, 0.45)
+          && wall(0.5, 0.25) && wall(0.57, 0.25) && !wall(0.62, 0.25)
+          && wall(0.2, 0.85) && !wall(0.12, 0.9)
+          && wall(0.0, 0.4) && wall(0.5, 0.0) && wall(0.99, 0.99);
+    std::remove(bitmapPath);
+
+    std::cout << "test_geometryRowsRasterizeIndependently: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_geometryErrors() {
+    const char* invalid[] = {
+        "wall rectangle 0 0 1\n",
+        "\nwall circle 0.5 0.5 x\n",
+        "wall triangle 0 0 1 1 0 1\n",
+        "hole rectangle 0 0 1 1\n",
+        "bitmap missing.pgm\n",
+        "# nothing but comments\n",
+    };
+    bool passed = true;
+    for (const char* text : invalid) {
+        Geometry geometry;
+        std::string error;
+        passed = passed && !parseGeometry(text, ".", geometry, error) && !error.empty();
+    }
+    Geometry geometry;
+    std::string error;
+    parseGeometry("\nwall circle 0.5 0.5 x\n", ".", geometry, error);
+    passed = passed && error.find("line 2") == 0;
+    passed = passed && directoryOf("geometry.txt") == "." && directoryOf("runs/a/geometry.txt") == "runs/a";
+
+    std::cout << "test_geometryErrors: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_slitGeometryMatchesReference();
+    test_geometryRowsRasterizeIndependently();
+    test_geometryErrors();
+    return 0;
+}
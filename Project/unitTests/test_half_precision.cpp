@@ -0,0 +1,134 @@
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "half_float.h"
+#include "half_solver.h"
+#include "simulation.h"
+
+// Without F16C the row conversions are the portable ones, so there is nothing to compare
+#if defined(__F16C__)
+void test_halfConversionMatchesHardware() {
+    // Every fp16 value decodes to the same float on both paths
+    std::vector<uint16_t> halves(65536);
+    for (int h = 0; h < 65536; ++h) {
+        halves[h] = static_cast<uint16_t>(h);
+    }
+    std::vector<float> decoded(halves.size());
+    decodeRow(STORAGE_FP16, halves.data(), decoded.data(), static_cast<int>(halves.size()));
+    bool passed = true;
+    for (int h = 0; h < 65536 && passed; ++h) {
+        float portable = halfToFloat(halves[h]);
+        passed = std::isnan(portable) ? std::isnan(decoded[h]) : portable == decoded[h]
+              && std::signbit(portable) == std::signbit(decoded[h]);
+    }
+
+    // A sweep over float bit patterns, dense enough to hit every exponent,
+    // rounds the same way on both paths
+    std::vector<float> floats;
+    for (uint64_t bits = 0; bits <= 0xffffffffu; bits += 65521) {
+        uint32_t pattern = static_cast<uint32_t>(bits);
+        float value;
+        std::memcpy(&value, &pattern, sizeof(value));
+        floats.push_back(value);
+    }
+    std::vector<uint16_t> encoded(floats.size());
+    for (int format = STORAGE_FP16; format <= STORAGE_BF16 && passed; ++format) {
+        StorageFormat f = static_cast<StorageFormat>(format);
+        encodeRow(f, floats.data(), encoded.data(), static_cast<int>(floats.size()));
+        for (size_t k = 0; k < floats.size() && passed; ++k) {
+            uint16_t portable = f == STORAGE_FP16 ? floatToHalf(floats[k]) : floatToBfloat16(floats[k]);
+            bool nan = std::isnan(floats[k]);
+            passed = nan ? (encoded[k] & 0x7fff) > (f == STORAGE_FP16 ? 0x7c00 : 0x7f80) : encoded[k] == portable;
+        }
+    }
+
+    std::cout << "test_halfConversionMatchesHardware: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+#endif
+
+void test_halfRounding() {
+    // fp16: exact values, ties to even, overflow and subnormals
+    bool passed = floatToHalf(1.0f) == 0x3c00 && floatToHalf(-2.0f) == 0xc000 && floatToHalf(65504.0f) == 0x7bff
+               && floatToHalf(65520.0f) == 0x7c00 && floatToHalf(65519.0f) == 0x7bff
+               && floatToHalf(std::ldexp(1.0f, -24)) == 0x0001 && floatToHalf(std::ldexp(1.0f, -25)) == 0x0000
+               && floatToHalf(std::ldexp(3.0f, -26)) == 0x0001
+               && floatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3c00
+               && floatToHalf(1.0f + std::ldexp(3.0f, -11)) == 0x3c02
+               && floatToHalf(std::numeric_limits<float>::infinity()) == 0x7c00
+               && std::isnan(halfToFloat(floatToHalf(std::numeric_limits<float>::quiet_NaN())))
+               && halfToFloat(0x0001) == std::ldexp(1.0f, -24) && halfToFloat(0x03ff) == std::ldexp(1023.0f, -24);
+
+    // bf16: the upper half of the float, rounded to nearest even
+    passed = passed && floatToBfloat16(1.0f) == 0x3f80 && bfloat16ToFloat(0x3f80) == 1.0f
+          && floatToBfloat16(1.0f + std::ldexp(1.0f, -8)) == 0x3f80
+          && floatToBfloat16(1.0f + std::ldexp(3.0f, -8)) == 0x3f82
+          && floatToBfloat16(3.0e38f) == 0x7f62 && floatToBfloat16(3.4e38f) == 0x7f80
+          && floatToBfloat16(std::numeric_limits<float>::denorm_min()) == 0x0000
+          && std::isnan(bfloat16ToFloat(floatToBfloat16(std::numeric_limits<float>::quiet_NaN())));
+
+    // Round trips of representable values are exact
+    for (int h = 0; h < 0x7c00 && passed; ++h) {
+        passed = floatToHalf(halfToFloat(static_cast<uint16_t>(h))) == h;
+    }
+    for (int b = 0x0080; b < 0x7f80 && passed; ++b) {
+        passed = floatToBfloat16(bfloat16ToFloat(static_cast<uint16_t>(b))) == b;
+    }
+
+    std::cout << "test_halfRounding: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_halfSolverTracksDouble() {
+    SimulationConfig config = defaultConfig();
+    config.N = 64;
+    config.tEnd = 1.0;
+    double errors[2];
+    double screens[2];
+    bool passed = true;
+    for (int format = STORAGE_FP16; format <= STORAGE_BF16; ++format) {
+        Simulation reference;
+        initializeSimulation(reference, config, false);
+        HalfSimulation sim;
+        initializeHalfSimulation(sim, config, static_cast<StorageFormat>(format));
+        double worst = 0.0;
+        while (reference.t < config.tEnd) {
+            stepHalfSimulation(sim);
+            stepSimulation(reference);
+            worst = std::max(worst, fieldError(sim, reference).relativeL2);
+        }
+        errors[format] = worst;
+        screens[format] = screenError(sim.screen, reference.screen);
+        passed = passed && sim.t == reference.t && fieldEnergy(reference) > 0.0;
+    }
+
+    // Rounding to 11 bits keeps the field within a percent, 8 bits within ten;
+    // the walls and the barrier stay exactly zero
+    passed = passed && errors[STORAGE_FP16] > 0.0 && errors[STORAGE_FP16] < 1e-2 && errors[STORAGE_BF16] < 1e-1
+          && errors[STORAGE_FP16] < errors[STORAGE_BF16] && screens[STORAGE_FP16] < 1e-2 && screens[STORAGE_BF16] < 1e-1;
+
+    HalfSimulation sim;
+    initializeHalfSimulation(sim, config, STORAGE_FP16);
+    for (int step = 0; step < 50; ++step) {
+        stepHalfSimulation(sim);
+    }
+    std::vector<std::vector<double>> field = decodedField(sim);
+    for (int i = 1; i < config.N && passed; ++i) {
+        for (int j = 0; j < config.N && passed; ++j) {
+            passed = sim.active[static_cast<size_t>(i) * config.N + j] || field[i][j] == 0.0;
+        }
+    }
+
+    std::cout << "test_halfSolverTracksDouble: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+#if defined(__F16C__)
+    test_halfConversionMatchesHardware();
+#endif
+    test_halfRounding();
+    test_halfSolverTracksDouble();
+    return 0;
+}
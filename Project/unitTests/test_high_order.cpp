@@ -0,0 +1,65 @@
+#include <iostream>
+#include <cmath>
+#include "high_order.h"
+#include "simulation.h"
+
+void test_modifiedEquationIsFourthOrder() {
+    SimulationConfig config = defaultConfig();
+    config.N = 48;
+    config.tEnd = 0.3;
+
+    // Halving the step divides the time error by 2^order
+    HighOrderSimulation reference;
+    TimeStep fine = chooseTimeStep(config, SCHEME_MODIFIED_EQUATION, 0.04);
+    initializeHighOrder(reference, config, SCHEME_MODIFIED_EQUATION, fine);
+    runHighOrder(reference, fine.steps);
+    double ratios[2];
+    for (int s = 0; s < 2; ++s) {
+        TimeScheme scheme = s == 0 ? SCHEME_LEAPFROG : SCHEME_MODIFIED_EQUATION;
+        double errors[2];
+        for (int k = 0; k < 2; ++k) {
+            TimeStep timeStep = chooseTimeStep(config, scheme, 0.64 / (1 << k));
+            HighOrderSimulation sim;
+            initializeHighOrder(sim, config, scheme, timeStep);
+            runHighOrder(sim, timeStep.steps);
+            errors[k] = relativeDifference(sim.U, reference.U);
+        }
+        ratios[s] = errors[0] / errors[1];
+    }
+    bool passed = ratios[0] > 3.0 && ratios[0] < 5.0 && ratios[1] > 12.0;
+
+    std::cout << "test_modifiedEquationIsFourthOrder: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_automaticTimeStep() {
+    SimulationConfig config = defaultConfig();
+    TimeStep leapfrog = chooseTimeStep(config, SCHEME_LEAPFROG);
+    TimeStep modified = chooseTimeStep(config, SCHEME_MODIFIED_EQUATION);
+
+    // Leapfrog takes the steps of the reference; both end exactly at tEnd
+    bool passed = leapfrog.steps == 725 && modified.steps < leapfrog.steps
+               && modified.courant <= courantLimit(SCHEME_MODIFIED_EQUATION)
+               && std::fabs(modified.steps * modified.dt - config.tEnd) < 1e-12
+               && accuracyCourant(config, SCHEME_MODIFIED_EQUATION) > courantLimit(SCHEME_LEAPFROG);
+
+    // Stable at the automatic step, unstable just above the limit
+    config.N = 32;
+    config.tEnd = 4.0;
+    for (int k = 0; k < 2; ++k) {
+        TimeStep timeStep = chooseTimeStep(config, SCHEME_MODIFIED_EQUATION,
+                                           k == 0 ? 0.0 : 1.05 * courantLimit(SCHEME_MODIFIED_EQUATION));
+        HighOrderSimulation sim;
+        initializeHighOrder(sim, config, SCHEME_MODIFIED_EQUATION, timeStep);
+        runHighOrder(sim, timeStep.steps);
+        double energy = highOrderEnergy(sim);
+        passed = passed && (k == 0 ? energy < 1e4 : !(energy < 1e4));
+    }
+
+    std::cout << "test_automaticTimeStep: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_modifiedEquationIsFourthOrder();
+    test_automaticTimeStep();
+    return 0;
+}
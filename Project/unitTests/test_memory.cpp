@@ -0,0 +1,26 @@
+#include <iostream>
+#include <vector>
+#include "memory.h"
+
+void test_projectedMemoryMatchesAllocation() {
+    // Odd sizes so that the bit vectors end in partly used words
+    const int rows = 37;
+    const int cols = 131;
+    std::vector<std::vector<double>> nested(rows, std::vector<double>(cols, 0.0));
+    std::vector<std::vector<bool>> nestedMask(rows, std::vector<bool>(cols, false));
+    std::vector<double> flat(rows * cols, 0.0);
+    std::vector<bool> flatMask(rows * cols, false);
+
+    bool passed = bytesOf(nested) == nestedDoubleBytes(rows, cols)
+               && bytesOf(nestedMask) == nestedMaskBytes(rows, cols)
+               && bytesOf(flat) == flatDoubleBytes(rows, cols)
+               && bytesOf(flatMask) == flatMaskBytes(rows, cols)
+               && peakResidentBytes() > bytesOf(flat);
+
+    std::cout << "test_projectedMemoryMatchesAllocation: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_projectedMemoryMatchesAllocation();
+    return 0;
+}
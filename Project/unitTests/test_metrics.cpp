@@ -0,0 +1,81 @@
+#include <iostream>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include "metrics.h"
+
+static MetricsSample makeSample(long long step) {
+    // Every value derives from the step, so a torn snapshot is detectable
+    MetricsSample sample;
+    sample.step = step;
+    sample.time = 0.5 * step;
+    sample.stepRate = 0.0;
+    sample.energy = 2.0 * step;
+    sample.computeSeconds = 3.0 * step;
+    sample.waitSeconds = 4.0 * step;
+    sample.imbalance = 1.0 + step;
+    return sample;
+}
+
+static bool consistent(const MetricsSample& s) {
+    return s.time == 0.5 * s.step && s.energy == 2.0 * s.step && s.computeSeconds == 3.0 * s.step
+        && s.waitSeconds == 4.0 * s.step && s.imbalance == 1.0 + s.step;
+}
+
+void test_metricsRoundTrip() {
+    const char* path = "test_metrics.bin";
+    MetricsSnapshot snapshot;
+    bool passed;
+    {
+        MetricsWriter writer;
+        passed = writer.open(path, 3, 8, 2.0) && readMetrics(path, snapshot) && snapshot.sample.step == 0
+              && !snapshot.finished;
+
+        writer.publish(makeSample(10));
+        passed = passed && readMetrics(path, snapshot) && snapshot.rank == 3 && snapshot.ranks == 8
+              && snapshot.endTime == 2.0 && snapshot.sample.step == 10 && consistent(snapshot.sample)
+              && snapshot.sample.stepRate > 0.0 && !snapshot.finished;
+
+        writer.finish(makeSample(20));
+    }
+    // The last values stay readable after the writer is gone
+    passed = passed && readMetrics(path, snapshot) && snapshot.finished && snapshot.sample.step == 20;
+    std::remove(path);
+    passed = passed && !readMetrics(path, snapshot);
+
+    std::cout << "test_metricsRoundTrip: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_metricsConcurrentReads() {
+    const char* path = "test_metrics_concurrent.bin";
+    MetricsWriter writer;
+    bool passed = writer.open(path, 0, 1, 1.0);
+    writer.publish(makeSample(1));
+
+    std::atomic<bool> done(false);
+    std::thread publisher([&]() {
+        for (long long step = 2; step < 200000; ++step) {
+            writer.publish(makeSample(step));
+        }
+        done = true;
+    });
+
+    long long last = 0;
+    int reads = 0;
+    while (!done || reads == 0) {
+        MetricsSnapshot snapshot;
+        passed = passed && readMetrics(path, snapshot) && consistent(snapshot.sample) && snapshot.sample.step >= last;
+        last = snapshot.sample.step;
+        ++reads;
+    }
+    publisher.join();
+    std::remove(path);
+
+    std::cout << "test_metricsConcurrentReads: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_metricsRoundTrip();
+    test_metricsConcurrentReads();
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <mpi.h>
+#include "alloc_counter.h"
+#include "halo.h"
+
+void test_mpiStepDoesNotAllocate() {
+    // The time loop of the MPI solver with deep halos on a line of all ranks
+    int size, rank;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    int dims[1] = { size };
+    int periods[1] = { 0 };
+    MPI_Comm cart;
+    MPI_Cart_create(MPI_COMM_WORLD, 1, dims, periods, 0, &cart);
+    MPI_Comm_rank(cart, &rank);
+
+    const int n = 64;
+    LocalGrid grid;
+    grid.haloWidth = 2;
+    grid.local_N = n / size + (rank < n % size ? 1 : 0);
+    grid.start_row = rank * (n / size) + std::min(rank, n % size);
+    grid.rows = grid.local_N + 2 * grid.haloWidth;
+    grid.cols = n;
+
+    const size_t cells = static_cast<size_t>(grid.rows) * n;
+    std::vector<double> U(cells, 0.0);
+    std::vector<double> Uprev(cells, 0.0);
+    std::vector<double> Unew(cells, 0.0);
+    for (int j = 0; j < n; ++j) {
+        U[static_cast<size_t>(grid.haloWidth) * n + j] = 1.0;
+    }
+
+    HaloExchange halo(cart, grid);
+    auto step = [&](int s) {
+        int subStep = s % grid.haloWidth;
+        if (subStep == 0) {
+            MPI_Request request;
+            halo.post(U, Uprev, &request);
+            MPI_Wait(&request, MPI_STATUS_IGNORE);
+        }
+        for (int i = 1 + subStep; i < grid.rows - 1 - subStep; ++i) {
+            for (int j = 1; j < n - 1; ++j) {
+                size_t idx = static_cast<size_t>(i) * n + j;
+                double laplacian = (U[idx - n] + U[idx + n] + U[idx - 1] + U[idx + 1] - 4.0 * U[idx]);
+                Unew[idx] = 2.0 * U[idx] - Uprev[idx] + 0.25 * laplacian;
+            }
+        }
+        Uprev.swap(U);
+        U.swap(Unew);
+    };
+
+    // One set of halo datatypes is built for each of the three buffer pairs
+    int s = 0;
+    for (; s < 3 * grid.haloWidth; ++s) {
+        step(s);
+    }
+    long long before = allocationCount();
+    for (; s < 3 * grid.haloWidth + 20; ++s) {
+        step(s);
+    }
+    int allocated = allocationCount() != before ? 1 : 0;
+    int anyAllocated = 0;
+    MPI_Allreduce(&allocated, &anyAllocated, 1, MPI_INT, MPI_MAX, cart);
+    bool passed = allocationCountingEnabled && anyAllocated == 0;
+
+    if (rank == 0) {
+        std::cout << "test_mpiStepDoesNotAllocate: " << (passed ? "PASSED" : "FAILED") << std::endl;
+    }
+    MPI_Comm_free(&cart);
+}
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+    test_mpiStepDoesNotAllocate();
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include <iostream>
+#include <vector>
+#include "alloc_counter.h"
+#include "partition.h"
+#include "probes.h"
+#include "solver.h"
+
+void test_openMpStepDoesNotAllocate() {
+    std::vector<double> xlin(N);
+    std::vector<std::vector<double>> U(N, std::vector<double>(N, 0.0));
+    std::vector<std::vector<double>> Uprev(N, std::vector<double>(N, 0.0));
+    std::vector<std::vector<double>> Unew(N, std::vector<double>(N, 0.0));
+    std::vector<std::vector<bool>> mask(N, std::vector<bool>(N, false));
+    initializeGrid(U, mask, xlin);
+
+    std::vector<int> bounds = balancedRowPartition(mask, 4);
+    std::vector<Probe> locations(1);
+    locations[0].x = 0.5;
+    locations[0].y = 0.9;
+    ProbeRecorder probes(locations, N, boxsize, 0.001, 0, N - 1, 64);
+
+    // The first step starts the thread pool of the OpenMP runtime
+    double t = 0.0;
+    auto step = [&] {
+        sampleProbes(probes, U);
+        calculateLaplacian(U, Uprev, Unew, mask, 0.5, bounds);
+        rotateGrids(U, Uprev, Unew);
+        applyBoundaryConditions(U, mask, t, xlin);
+        t += 0.001;
+    };
+    step();
+
+    long long before = allocationCount();
+    for (int s = 0; s < 20; ++s) {
+        step();
+    }
+    bool passed = allocationCountingEnabled && allocationCount() == before;
+
+    std::cout << "test_openMpStepDoesNotAllocate: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_openMpStepDoesNotAllocate();
+    return 0;
+}
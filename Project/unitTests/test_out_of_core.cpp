@@ -0,0 +1,74 @@
+#include <iostream>
+#include <cstdio>
+#include <vector>
+#include "checksum.h"
+#include "mapped_field.h"
+#include "out_of_core.h"
+#include "simulation.h"
+
+void test_mappedFieldKeepsReleasedRows() {
+    const char* path = "test_mapped_field.bin";
+    const int rows = 300;
+    const int cols = 700;
+    MappedField field;
+    bool passed = field.open(path, rows, cols) && field.isOpen() && field.bytes() == sizeof(double) * rows * cols;
+    for (int i = 0; passed && i < rows; ++i) {
+        passed = field.row(i)[0] == 0.0 && field.row(i)[cols - 1] == 0.0;
+        for (int j = 0; j < cols; ++j) {
+            field.row(i)[j] = i + 1e-3 * j;
+        }
+    }
+
+    // Rows dropped from memory come back from the page cache or the file
+    field.release(0, rows / 2);
+    field.release(rows / 2, rows);
+    field.prefetch(0, rows);
+    for (int i = 0; passed && i < rows; ++i) {
+        for (int j = 0; passed && j < cols; ++j) {
+            passed = field.row(i)[j] == i + 1e-3 * j;
+        }
+    }
+    std::remove(path);
+
+    MappedField missing;
+    passed = passed && !missing.open("missing_directory/field.bin", rows, cols) && !missing.isOpen();
+
+    std::cout << "test_mappedFieldKeepsReleasedRows: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_outOfCoreMatchesReference() {
+    SimulationConfig config = defaultConfig();
+    config.N = 64;
+    config.tEnd = 0.5;
+
+    Simulation reference;
+    initializeSimulation(reference, config, false);
+    std::vector<FieldChecksum> expected;
+    expected.push_back(fieldChecksum(fullField(reference), 0));
+    for (long step = 1; reference.t < config.tEnd; ++step) {
+        stepSimulation(reference);
+        if (step % 5 == 0 || !(reference.t < config.tEnd)) {
+            expected.push_back(fieldChecksum(fullField(reference), step));
+        }
+    }
+
+    // Bands of one row, bands narrower than the halos, and a single band
+    const int bands[][2] = { { 1, 1 }, { 5, 3 }, { 7, 8 }, { 64, 4 } };
+    bool passed = true;
+    for (const int* band : bands) {
+        OutOfCoreGrid grid;
+        std::vector<FieldChecksum> checksums;
+        passed = passed && initializeOutOfCore(grid, config, ".", band[0], band[1]);
+        FieldChecksum result = runOutOfCore(grid, &checksums, 5);
+        passed = passed && firstDivergence(expected, checksums, config.N, 0.0) == -1
+              && result.hash == expected.back().hash && grid.t == reference.t;
+    }
+
+    std::cout << "test_outOfCoreMatchesReference: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_mappedFieldKeepsReleasedRows();
+    test_outOfCoreMatchesReference();
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "parallel_simulation.h"
+#include "simulation.h"
+
+void test_parallelMatchesSerial() {
+    SimulationConfig config = defaultConfig();
+    config.N = 64;
+    config.tEnd = 1.0;
+
+    bool passed = true;
+    for (int symmetry = 0; symmetry < 2; ++symmetry) {
+        Simulation serial;
+        Simulation parallel;
+        initializeSimulation(serial, config, symmetry == 1);
+        initializeSimulation(parallel, config, symmetry == 1);
+        while (serial.t < config.tEnd) {
+            stepSimulation(serial);
+            parallelStl::stepSimulation(parallel);
+        }
+
+        // The stencil is evaluated identically; only the reduction order differs
+        double energy = fieldEnergy(serial);
+        passed = passed && parallel.screen == serial.screen && parallel.U == serial.U && energy > 0.0
+              && std::fabs(parallelStl::fieldEnergy(parallel) - energy) <= 1e-12 * energy;
+    }
+    passed = passed && parallelStl::runSimulation(config) == runSimulation(config);
+
+    std::cout << "test_parallelMatchesSerial: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_parallelMatchesSerial();
+    return 0;
+}
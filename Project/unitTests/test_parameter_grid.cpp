@@ -0,0 +1,75 @@
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "parameter_grid.h"
+#include "simulation.h"
+
+// The parameters of the sweep
+static bool setParameter(SimulationConfig& config, const std::string& name, double value) {
+    if (name == "N") config.N = static_cast<int>(value);
+    else if (name == "tEnd") config.tEnd = value;
+    else if (name == "frequency") config.frequency = value;
+    else return false;
+    return true;
+}
+
+// Writes a grid file and reads it back
+static bool readGrid(const char* text, std::vector<SimulationConfig>& configs) {
+    const char* path = "test_parameter_grid.txt";
+    FILE* file = std::fopen(path, "w");
+    std::fputs(text, file);
+    std::fclose(file);
+    bool read = readParameterGrid(path, defaultConfig(), setParameter, configs);
+    std::remove(path);
+    return read;
+}
+
+void test_readParameterGrid() {
+    // Every combination, the last line varying fastest; the rest keep their default
+    std::vector<SimulationConfig> configs;
+    bool passed = readGrid("# sizes\nN 64 128\n\n  frequency 5 10 20 # Hz\ntEnd 1.0\n", configs)
+               && configs.size() == 6;
+    for (size_t c = 0; passed && c < configs.size(); ++c) {
+        const double frequencies[3] = { 5.0, 10.0, 20.0 };
+        passed = configs[c].N == (c < 3 ? 64 : 128) && configs[c].frequency == frequencies[c % 3]
+              && configs[c].tEnd == 1.0 && configs[c].c == defaultConfig().c;
+    }
+
+    // A file without parameters is the default configuration
+    passed = passed && readGrid("\n# nothing\n", configs) && configs.size() == 1
+          && configs[0].N == defaultConfig().N;
+
+    std::cout << "test_readParameterGrid: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_readParameterGridRejects() {
+    // Unknown names, missing values and trailing junk reject the file instead of shrinking the grid
+    std::vector<SimulationConfig> configs;
+    bool passed = !readGrid("N 64\nfrequency\n", configs)
+               && !readGrid("N 64\nbogus\n", configs)
+               && !readGrid("N 64\nbogus 1 2\n", configs)
+               && !readGrid("frequency 5 abc\n", configs)
+               && !readGrid("N 64x\n", configs);
+
+    // The line of the error is read from the file itself
+    std::vector<ParameterLine> lines;
+    const char* path = "test_parameter_grid.txt";
+    FILE* file = std::fopen(path, "w");
+    std::fputs("# comment\n\nN 64 128\nfrequency 5 abc\ntEnd\n", file);
+    std::fclose(file);
+    passed = passed && readParameterLines(path, lines) && lines.size() == 3
+          && lines[0].line == 3 && lines[0].numeric && lines[0].values.size() == 2
+          && lines[1].line == 4 && !lines[1].numeric && lines[1].values.size() == 1
+          && lines[2].line == 5 && lines[2].numeric && lines[2].values.empty();
+    std::remove(path);
+    passed = passed && !readParameterLines("does_not_exist.txt", lines);
+
+    std::cout << "test_readParameterGridRejects: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_readParameterGrid();
+    test_readParameterGridRejects();
+    return 0;
+}
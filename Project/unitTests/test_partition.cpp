@@ -0,0 +1,41 @@
+#include <iostream>
+#include <vector>
+#include "partition.h"
+
+void test_balancedRowPartition() {
+    // The upper half is mostly wall, so it needs more rows per band
+    const int n = 66;
+    std::vector<std::vector<bool>> mask(n, std::vector<bool>(n, false));
+    for (int i = 0; i < n; ++i) {
+        mask[0][i] = mask[n-1][i] = mask[i][0] = mask[i][n-1] = true;
+    }
+    for (int i = 1; i < n / 2; ++i) {
+        for (int j = 1; j < n - 8; ++j) {
+            mask[i][j] = true;
+        }
+    }
+
+    const int parts = 4;
+    std::vector<int> bounds = balancedRowPartition(mask, parts);
+    std::vector<long> work = partitionWork(mask, bounds);
+
+    long total = 0;
+    for (int p = 0; p < parts; ++p) {
+        total += work[p];
+    }
+    bool passed = bounds.size() == parts + 1 && bounds[0] == 1 && bounds[parts] == n - 1 && total == 32 * 7 + 32 * 64
+               && bounds[1] - bounds[0] > bounds[parts] - bounds[parts - 1]
+               && partitionImbalance(work) < 1.05;
+
+    // Bands are contiguous and never empty while there are more rows than bands
+    for (int p = 0; p < parts; ++p) {
+        passed = passed && bounds[p] < bounds[p + 1];
+    }
+
+    std::cout << "test_balancedRowPartition: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_balancedRowPartition();
+    return 0;
+}
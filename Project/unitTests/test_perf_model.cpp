@@ -0,0 +1,64 @@
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include "perf_model.h"
+
+void test_fitPingPong() {
+    // Exact line with 2 us latency and 5 GB/s; the small sizes are ignored by the fit
+    const char* path = "test_pingpong.txt";
+    FILE* file = std::fopen(path, "w");
+    std::fprintf(file, "8 0.001\n");
+    for (long size = 512; size <= 4194304; size *= 2) {
+        std::fprintf(file, "%ld %.12e\n", size, 2e-6 + size / 5e9);
+    }
+    std::fclose(file);
+
+    LinkParameters link;
+    bool passed = fitPingPong(path, 1e-6, link) && std::fabs(link.latency - 2e-6) < 1e-9
+               && std::fabs(link.bandwidth - 5e9) < 1e3;
+    std::remove(path);
+
+    std::cout << "test_fitPingPong: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_predictStep() {
+    MachineModel model;
+    model.cellsPerSecond = 1e8;
+    model.intra.latency = 1e-6;
+    model.intra.bandwidth = 1e10;
+    model.inter.latency = 1e-5;
+    model.inter.bandwidth = 1e9;
+    model.coresPerNode = 4;
+
+    // A single rank does not communicate, more ranks split the compute
+    StepPrediction serial = predictStep(model, 256, 1, 1);
+    StepPrediction split = predictStep(model, 256, 4, 1);
+    bool passed = serial.halo == 0.0 && split.compute < serial.compute;
+
+    // Leaving the node exposes the slower link once the owned rows no longer hide it
+    StepPrediction onNode = predictStep(model, 256, 4, 1);
+    StepPrediction offNode = predictStep(model, 256, 128, 1);
+    passed = passed && offNode.halo > onNode.halo;
+
+    // Deeper halos send fewer messages at the price of redundant rows
+    StepPrediction deep = predictStep(model, 256, 128, 2);
+    passed = passed && deep.halo < offNode.halo && deep.compute > offNode.compute;
+
+    std::cout << "test_predictStep: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_unevenDecomposition() {
+    // Like the solver, any rank count splits the rows and the largest block sets the pace
+    bool passed = validDecomposition(250, 3, 1) && validDecomposition(10, 3, 3) && !validDecomposition(10, 3, 4)
+               && !validDecomposition(10, 11, 1) && cellsPerStep(10, 3, 1) == 10.0 * 4
+               && cellsPerStep(10, 3, 2) == 10.0 * 5 && cellsPerStep(12, 3, 1) == 12.0 * 4;
+
+    std::cout << "test_unevenDecomposition: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_fitPingPong();
+    test_predictStep();
+    test_unevenDecomposition();
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include "probes.h"
+
+void test_probeInterpolation() {
+    const int n = 16;
+    const double size = 1.0;
+    const double dx = size / n;
+
+    // A linear field is reproduced exactly by bilinear interpolation
+    auto field = [&](int i, int j) { return 2.0 * (i + 0.5) * dx + 3.0 * (j + 0.5) * dx; };
+
+    std::vector<Probe> probes;
+    Probe onGrid = { 0.5 * dx + 4 * dx, 0.5 * dx + 7 * dx };
+    Probe offGrid = { 0.37, 0.61 };
+    probes.push_back(onGrid);
+    probes.push_back(offGrid);
+
+    ProbeRecorder recorder(probes, n, size, 0.1, 0, n - 1, 1);
+    bool passed = recorder.size() == 2;
+    if (passed) {
+        recorder.sampleAll(field);
+
+        // Read the values back through a file holding a single block
+        const char* path = "test_probes.bin";
+        recorder.open(path);
+        recorder.endStep();
+
+        FILE* file = std::fopen(path, "rb");
+        std::fseek(file, 4 + 4 + 4 + 8 + 16 * 2, SEEK_SET);
+        for (int p = 0; p < 2 && passed; ++p) {
+            int32_t probe, count;
+            int64_t first;
+            double value;
+            passed = std::fread(&probe, sizeof(probe), 1, file) == 1
+                  && std::fread(&count, sizeof(count), 1, file) == 1
+                  && std::fread(&first, sizeof(first), 1, file) == 1
+                  && std::fread(&value, sizeof(value), 1, file) == 1;
+            double expected = 2.0 * probes[probe].y + 3.0 * probes[probe].x;
+            passed = passed && count == 1 && first == 0 && std::fabs(value - expected) < 1e-12;
+        }
+        std::fclose(file);
+        std::remove(path);
+    }
+
+    std::cout << "test_probeInterpolation: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_probeOwnership() {
+    const int n = 16;
+    std::vector<Probe> probes;
+    Probe top = { 0.5, 0.1 };
+    Probe bottom = { 0.5, 0.9 };
+    probes.push_back(top);
+    probes.push_back(bottom);
+
+    // Rows 0..7 own the first probe only, rows 8..15 the second one
+    ProbeRecorder upper(probes, n, 1.0, 0.1, 0, 7, 8);
+    ProbeRecorder lower(probes, n, 1.0, 0.1, 8, 15, 8);
+    bool passed = upper.size() == 1 && lower.size() == 1;
+
+    std::cout << "test_probeOwnership: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_probeInterpolation();
+    test_probeOwnership();
+    return 0;
+}
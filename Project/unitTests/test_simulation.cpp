@@ -1,5 +1,7 @@
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <cmath>
 #include "simulation.h"
 
 void test_initializeGrid() {
@@ -41,9 +43,156 @@ void test_applyBoundaryConditions() {
     std::cout << "test_applyBoundaryConditions: " << (passed ? "PASSED" : "FAILED") << std::endl;
 }
 
+void test_defaultConfigGeometry() {
+    std::vector<double> xlin(N);
+    std::vector<std::vector<double>> U(N, std::vector<double>(N, 0.0));
+    std::vector<std::vector<bool>> mask(N, std::vector<bool>(N, false));
+
+    initializeGrid(U, mask, xlin);
+
+    // The default configuration reproduces the original slit positions
+    bool passed = true;
+    for (int i = N/4; i < 9*N/32 && passed; ++i) {
+        for (int j = 1; j < N-1; ++j) {
+            bool slit = (j >= 5*N/16 && j < 3*N/8) || (j >= 5*N/8 && j < 11*N/16);
+            if (mask[i][j] == slit) {
+                passed = false;
+                break;
+            }
+        }
+    }
+
+    std::cout << "test_defaultConfigGeometry: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_runSimulation() {
+    SimulationConfig config = defaultConfig();
+    config.N = 64;
+    config.tEnd = 1.5;
+
+    // A leapfrog loop written out from the grid primitives, with the screen at row 7N/8
+    const int n = config.N;
+    std::vector<double> xlin(n);
+    std::vector<std::vector<double>> U(n, std::vector<double>(n, 0.0));
+    std::vector<std::vector<bool>> mask(n, std::vector<bool>(n, false));
+    initializeGrid(U, mask, xlin, config);
+    std::vector<std::vector<double>> Uprev = U;
+    std::vector<std::vector<double>> Unew = U;
+    double dx = config.boxsize / n;
+    double dt = (std::sqrt(2)/2) * dx / config.c;
+    double fac = dt*dt * config.c*config.c / (dx*dx);
+    std::vector<double> expected(n, 0.0);
+    for (double t = 0.0; t < config.tEnd; t += dt) {
+        updateLaplacian(U, Uprev, Unew, mask, fac);
+        Uprev.swap(U);
+        U.swap(Unew);
+        applyBoundaryConditions(U, mask, t, xlin, config.frequency);
+        for (int j = 0; j < n; ++j) {
+            expected[j] += U[7*n/8][j] * U[7*n/8][j] * dt;
+        }
+    }
+
+    std::vector<double> screen = runSimulation(config, false);
+    std::vector<double> mirrored = runSimulation(config);
+
+    // Recorded values of this configuration guard against changes of the kernel itself
+    double total = 0.0;
+    double difference = 0.0;
+    for (int j = 0; j < n; ++j) {
+        total += screen[j];
+        difference = std::max(difference, std::fabs(mirrored[j] - screen[j]));
+    }
+    bool passed = static_cast<int>(screen.size()) == n && screen == expected
+               && std::fabs(total - 1.4959146658761682) < 1e-9
+               && std::fabs(screen[n/2] - 0.038697789813241582) < 1e-12
+               && difference <= 1e-9 * total;
+
+    std::cout << "test_runSimulation: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_mirrorSymmetry() {
+    SimulationConfig config = defaultConfig();
+    config.N = 64;
+    config.tEnd = 1.0;
+
+    Simulation sim;
+    initializeSimulation(sim, config);
+    bool passed = sim.mirrored && sim.U[0].size() == 33 && sim.mask[0].size() == 33;
+    while (sim.t < config.tEnd) {
+        stepSimulation(sim);
+    }
+
+    // The half domain reproduces the full one up to rounding
+    std::vector<double> full = runSimulation(config, false);
+    double largest = 0.0;
+    double difference = 0.0;
+    for (int j = 0; j < config.N; ++j) {
+        largest = std::max(largest, std::fabs(full[j]));
+        difference = std::max(difference, std::fabs(full[j] - sim.screen[j]));
+    }
+    passed = passed && largest > 0.0 && difference <= 1e-9 * largest;
+
+    std::vector<std::vector<double>> field = fullField(sim);
+    for (int i = 0; i < config.N && passed; ++i) {
+        passed = field[i].size() == static_cast<size_t>(config.N) && field[i][10] == field[i][config.N - 11];
+    }
+
+    // Slits that do not fall on grid lines break the symmetry
+    config.slitWidth = 0.05;
+    Simulation asymmetric;
+    initializeSimulation(asymmetric, config);
+    passed = passed && !asymmetric.mirrored && asymmetric.U[0].size() == static_cast<size_t>(config.N);
+
+    // So does an inflow profile that is not symmetric within the box
+    config = defaultConfig();
+    config.N = 64;
+    config.boxsize = 1.5;
+    config.tEnd = 1.5;
+    Simulation stretched;
+    initializeSimulation(stretched, config);
+    passed = passed && !stretched.mirrored && stretched.U[0].size() == static_cast<size_t>(config.N)
+          && runSimulation(config) == runSimulation(config, false);
+
+    std::cout << "test_mirrorSymmetry: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_storedColumn() {
+    // Unmirrored grids store every column, the last one included
+    const int n = 64;
+    bool passed = true;
+    for (int j = 0; j < n; ++j) {
+        passed = passed && storedColumn(j, n, n) == j;
+    }
+
+    // Mirrored grids store the columns up to the centre and one reflecting column
+    const int cols = 33;
+    for (int j = 0; j < n; ++j) {
+        int expected = j < cols - 1 ? j : n - 1 - j;
+        passed = passed && storedColumn(j, n, cols) == expected;
+    }
+
+    // fullField() of an unmirrored simulation is its field
+    SimulationConfig config = defaultConfig();
+    config.N = n;
+    config.tEnd = 0.5;
+    Simulation sim;
+    initializeSimulation(sim, config, false);
+    while (sim.t < config.tEnd) {
+        stepSimulation(sim);
+    }
+    sim.U[n/2][n-1] = 1.0;
+    passed = passed && !sim.mirrored && fullField(sim) == sim.U;
+
+    std::cout << "test_storedColumn: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
 int main() {
     test_initializeGrid();
     test_applyBoundaryConditions();
+    test_defaultConfigGeometry();
+    test_runSimulation();
+    test_mirrorSymmetry();
+    test_storedColumn();
     return 0;
 }
 
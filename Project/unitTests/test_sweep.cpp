@@ -0,0 +1,107 @@
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <cstdlib>
+#include <string>
+#include "result_cache.h"
+#include "work_stealing_pool.h"
+
+void test_workStealingPoolRunsEveryJobOnce() {
+    const int numJobs = 200;
+    std::vector<std::atomic<int>> runs(numJobs);
+    for (int j = 0; j < numJobs; ++j) {
+        runs[j] = 0;
+    }
+
+    // Uneven jobs so that some workers run dry and have to steal
+    std::vector<WorkStealingPool::Job> jobs;
+    for (int j = 0; j < numJobs; ++j) {
+        jobs.push_back([&runs, j](int) {
+            volatile double sink = 0.0;
+            for (int k = 0; k < (j % 7) * 10000; ++k) {
+                sink = sink + k;
+            }
+            ++runs[j];
+        });
+    }
+
+    WorkStealingPool pool(4);
+    pool.run(jobs);
+
+    bool passed = true;
+    for (int j = 0; j < numJobs; ++j) {
+        if (runs[j] != 1) {
+            passed = false;
+            break;
+        }
+    }
+
+    std::cout << "test_workStealingPoolRunsEveryJobOnce: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_resultCacheReuse() {
+    const std::string directory = "test_cache";
+    std::system(("rm -rf " + directory).c_str());
+    ResultCache cache(directory);
+
+    // Long enough for the wave to pass the barrier and light the screen
+    SimulationConfig config = defaultConfig();
+    config.N = 32;
+    config.tEnd = 1.0;
+    SimulationConfig longer = config;
+    longer.tEnd = 1.25;
+
+    ResultCache::Outcome first, second, extended;
+    std::vector<std::vector<double>> computedField, cachedField, resumedField;
+    std::vector<double> computed = cache.run(config, first, &computedField);
+    std::vector<double> cached = cache.run(config, second, &cachedField);
+    std::vector<double> resumed = cache.run(longer, extended, &resumedField);
+
+    Simulation reference;
+    initializeSimulation(reference, longer);
+    while (reference.t < longer.tEnd) {
+        stepSimulation(reference);
+    }
+
+    // Hits and resumed runs are bit-identical to simulating from the start
+    bool passed = first == ResultCache::MISS && second == ResultCache::HIT && extended == ResultCache::PARTIAL
+               && *std::max_element(computed.begin(), computed.end()) > 0.0
+               && cached == computed && cachedField == computedField
+               && resumed == reference.screen && resumedField == fullField(reference);
+    std::system(("rm -rf " + directory).c_str());
+
+    std::cout << "test_resultCacheReuse: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_resultCacheResumeMatchesFullRun() {
+    const std::string directory = "test_cache_resume";
+    std::system(("rm -rf " + directory).c_str());
+    ResultCache cache(directory);
+
+    // The wave reaches the screen at 7/8 of the box, so both screens are lit
+    SimulationConfig config = defaultConfig();
+    config.N = 32;
+    config.tEnd = 1.0;
+    SimulationConfig longer = config;
+    longer.tEnd = 1.5;
+
+    ResultCache::Outcome first, extended;
+    std::vector<double> early = cache.run(config, first);
+    std::vector<double> resumed = cache.run(longer, extended);
+    std::vector<double> uninterrupted = runSimulation(longer);
+    double brightest = *std::max_element(uninterrupted.begin(), uninterrupted.end());
+
+    bool passed = first == ResultCache::MISS && extended == ResultCache::PARTIAL && brightest > 0.0
+               && resumed == uninterrupted && early != uninterrupted;
+    std::system(("rm -rf " + directory).c_str());
+
+    std::cout << "test_resultCacheResumeMatchesFullRun: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_workStealingPoolRunsEveryJobOnce();
+    test_resultCacheReuse();
+    test_resultCacheResumeMatchesFullRun();
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <iostream>
+#include <atomic>
+#include <vector>
+#include "partition.h"
+#include "pool_solver.h"
+#include "thread_pool.h"
+
+void test_spinBarrierPhases() {
+    // No thread may see the counter of a phase before all threads have added to it
+    const int threads = 4;
+    const int phases = 500;
+    bool passed = true;
+    for (int spinBudget : {0, 1000}) {
+        ThreadPool pool(threads, spinBudget, false);
+        std::atomic<int> counter(0);
+        std::atomic<bool> consistent(true);
+        pool.run([&](int) {
+            for (int phase = 0; phase < phases; ++phase) {
+                counter.fetch_add(1);
+                pool.barrier();
+                if (counter.load() != threads * (phase + 1)) {
+                    consistent = false;
+                }
+                pool.barrier();
+            }
+        });
+        passed = passed && consistent && counter == threads * phases && pool.size() == threads;
+        if (spinBudget == 0) {
+            passed = passed && pool.barrierFallbacks() > 0;
+        }
+    }
+
+    std::cout << "test_spinBarrierPhases: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_poolSolverMatchesOneThread() {
+    SimulationConfig config = defaultConfig();
+    config.N = 64;
+    config.tEnd = 1.0;
+
+    std::vector<std::vector<double>> fields[2];
+    long steps[2];
+    int counts[2] = { 1, 3 };
+    for (int k = 0; k < 2; ++k) {
+        PoolGrid grid;
+        initializePoolGrid(grid, config);
+        ThreadPool pool(counts[k], 1000, false);
+        steps[k] = runPoolSimulation(pool, grid, balancedRowPartition(grid.mask, counts[k]));
+        fields[k] = grid.U;
+    }
+
+    // Every cell is computed by one thread with the same expression
+    PoolGrid reference;
+    reference.U = fields[0];
+    bool passed = steps[0] == steps[1] && steps[0] > 0 && fields[0] == fields[1] && poolFieldEnergy(reference) > 0.0;
+
+    std::cout << "test_poolSolverMatchesOneThread: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_poolSolverMatchesReference() {
+    // The pool adds up its checksums per band; they must equal those of the
+    // reference solver at every step
+    SimulationConfig config = defaultConfig();
+    config.N = 64;
+    config.tEnd = 1.0;
+
+    PoolGrid grid;
+    initializePoolGrid(grid, config);
+    ThreadPool pool(3, 1000, false);
+    std::vector<FieldChecksum> checksums;
+    runPoolSimulation(pool, grid, balancedRowPartition(grid.mask, 3), &checksums, 1);
+
+    Simulation reference;
+    initializeSimulation(reference, config, false);
+    std::vector<FieldChecksum> expected(1, fieldChecksum(reference.U, 0));
+    for (int step = 1; reference.t < config.tEnd; ++step) {
+        stepSimulation(reference);
+        expected.push_back(fieldChecksum(reference.U, step));
+    }
+    bool passed = expected.size() > 2 && firstDivergence(expected, checksums, config.N, 0.0) == -1;
+
+    std::cout << "test_poolSolverMatchesReference: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_spinBarrierPhases();
+    test_poolSolverMatchesOneThread();
+    test_poolSolverMatchesReference();
+    return 0;
+}
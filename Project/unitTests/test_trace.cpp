@@ -0,0 +1,50 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include "trace.h"
+
+void test_traceThreads() {
+    // Every thread records into its own track
+    auto work = [] {
+        TRACE_SCOPE("compute");
+        volatile double sink = 0.0;
+        for (int k = 0; k < 1000; ++k) {
+            sink = sink + k;
+        }
+    };
+    std::thread first(work);
+    std::thread second(work);
+    first.join();
+    second.join();
+
+    std::string events = traceEvents(3, "rank 3");
+    bool passed = traceEnabled
+               && events.find("\"name\":\"compute\",\"ph\":\"X\",\"pid\":3,\"tid\":0") != std::string::npos
+               && events.find("\"name\":\"compute\",\"ph\":\"X\",\"pid\":3,\"tid\":1") != std::string::npos
+               && events.find("\"tid\":2") == std::string::npos
+               && events.find("\"args\":{\"name\":\"rank 3\"}") != std::string::npos;
+
+    std::cout << "test_traceThreads: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void test_traceClear() {
+    // Events recorded before a clear are not written again
+    {
+        TRACE_SCOPE("first run");
+    }
+    traceClear();
+    {
+        TRACE_SCOPE("second run");
+    }
+    std::string events = traceEvents(0, "rank 0");
+    bool passed = events.find("first run") == std::string::npos && events.find("second run") != std::string::npos
+               && events.find("\"args\":{\"name\":\"thread 0\"}") != std::string::npos;
+
+    std::cout << "test_traceClear: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_traceThreads();
+    test_traceClear();
+    return 0;
+}
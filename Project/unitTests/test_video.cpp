@@ -0,0 +1,103 @@
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "video.h"
+
+void test_videoStream() {
+    const int n = 16;
+    std::vector<std::vector<double>> U(n, std::vector<double>(n, 0.0));
+    std::vector<std::vector<bool>> mask(n, std::vector<bool>(n, false));
+    mask[0][0] = mask[0][1] = mask[1][0] = mask[1][1] = true;
+
+    const char* path = "test_video.y4m";
+    {
+        VideoWriter video(n, 2, 30);
+        video.open(path);
+        for (int frame = 0; frame < 5; ++frame) {
+            video.addFrame(U, mask);
+        }
+    }
+
+    FILE* file = std::fopen(path, "rb");
+    std::string data;
+    char chunk[4096];
+    size_t read;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.append(chunk, read);
+    }
+    std::fclose(file);
+    std::remove(path);
+
+    // 8x8 pixels, 4:4:4, five frames; a zero field is mid grey and the walled corner black
+    std::string header = "YUV4MPEG2 W8 H8 F30:1 Ip A1:1 C444 XCOLORRANGE=FULL\n";
+    const size_t frameBytes = 6 + 3 * 8 * 8;
+    bool passed = data.compare(0, header.size(), header) == 0
+               && data.size() == header.size() + 5 * frameBytes;
+    if (passed) {
+        const unsigned char* Y = reinterpret_cast<const unsigned char*>(data.data() + header.size() + 6);
+        passed = Y[0] == 0 && Y[1] == 128 && Y[63] == 128;
+    }
+
+    std::cout << "test_videoStream: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+static std::string readFile(const char* path) {
+    FILE* file = std::fopen(path, "rb");
+    std::string data;
+    char chunk[4096];
+    size_t read;
+    while (file != nullptr && (read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.append(chunk, read);
+    }
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+    std::remove(path);
+    return data;
+}
+
+void test_videoDownscaledFrames() {
+    // Pixels averaged by the caller, as the MPI output rank does, give the
+    // same stream as the field itself
+    const int n = 12;
+    const int scale = 3;
+    const int size = n / scale;
+    std::vector<std::vector<double>> U(n, std::vector<double>(n));
+    std::vector<std::vector<bool>> mask(n, std::vector<bool>(n, false));
+    std::vector<float> pixels(size * size, 0.0f);
+    std::vector<float> walls(size * size, 0.0f);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            U[i][j] = std::sin(0.7 * i - 0.3 * j);
+            mask[i][j] = (i + 2 * j) % 7 == 0;
+            pixels[(i / scale) * size + j / scale] += static_cast<float>(U[i][j]);
+            walls[(i / scale) * size + j / scale] += mask[i][j] ? 1.0f : 0.0f;
+        }
+    }
+    for (int p = 0; p < size * size; ++p) {
+        pixels[p] *= 1.0f / (scale * scale);
+        walls[p] *= 1.0f / (scale * scale);
+    }
+
+    {
+        VideoWriter field(n, scale, 30);
+        field.open("test_video_field.y4m");
+        field.addFrame(U, mask);
+        VideoWriter averaged(n, scale, 30);
+        averaged.open("test_video_pixels.y4m");
+        averaged.addFrame(pixels, walls);
+    }
+    std::string a = readFile("test_video_field.y4m");
+    std::string b = readFile("test_video_pixels.y4m");
+    bool passed = !a.empty() && a == b;
+
+    std::cout << "test_videoDownscaledFrames: " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    test_videoStream();
+    test_videoDownscaledFrames();
+    return 0;
+}